@@ -0,0 +1,116 @@
+#include "batch-query.hpp"
+
+namespace cledger {
+
+enum : uint32_t {
+  TLV_BATCH_QUERY = 461,
+  TLV_BATCH_WITH_PROOF = 462,
+  TLV_BATCH_RESPONSE = 463,
+  TLV_BATCH_ANSWER = 464,
+  TLV_BATCH_NACK = 465,
+};
+
+Block
+encodeBatchQuery(const BatchQuery& query)
+{
+  Block block(TLV_BATCH_QUERY);
+  for (const auto& certName : query.certNames) {
+    block.push_back(certName.wireEncode());
+  }
+  if (query.withProof) {
+    block.push_back(ndn::makeEmptyBlock(TLV_BATCH_WITH_PROOF));
+  }
+  block.encode();
+  return block;
+}
+
+BatchQuery
+decodeBatchQuery(const Block& block)
+{
+  BatchQuery query;
+  block.parse();
+  if (block.type() != TLV_BATCH_QUERY) {
+    NDN_THROW(std::runtime_error("TLV Type is incorrect"));
+  }
+  for (const auto &item : block.elements()) {
+    switch (item.type()) {
+      case ndn::tlv::Name:
+        query.certNames.emplace_back(item);
+        break;
+      case TLV_BATCH_WITH_PROOF:
+        query.withProof = true;
+        break;
+      default:
+        if (ndn::tlv::isCriticalType(item.type())) {
+          NDN_THROW(std::runtime_error("Unrecognized TLV Type: " + std::to_string(item.type())));
+        }
+        break;
+    }
+  }
+  if (query.certNames.size() > BatchQuery::MAX_BATCH_SIZE) {
+    NDN_THROW(std::runtime_error("Batch of " + std::to_string(query.certNames.size()) +
+                                 " certificates is over the limit"));
+  }
+  return query;
+}
+
+Block
+encodeBatchResponse(const std::vector<BatchAnswer>& answers)
+{
+  Block block(TLV_BATCH_RESPONSE);
+  for (const auto& answer : answers) {
+    Block item(TLV_BATCH_ANSWER);
+    item.push_back(answer.certName.wireEncode());
+    if (answer.content) {
+      item.push_back(*answer.content);
+    }
+    else {
+      item.push_back(ndn::makeEmptyBlock(TLV_BATCH_NACK));
+    }
+    item.encode();
+    block.push_back(item);
+  }
+  block.encode();
+  return block;
+}
+
+std::vector<BatchAnswer>
+decodeBatchResponse(const Block& block)
+{
+  std::vector<BatchAnswer> answers;
+  block.parse();
+  if (block.type() != TLV_BATCH_RESPONSE) {
+    NDN_THROW(std::runtime_error("TLV Type is incorrect"));
+  }
+  for (const auto &item : block.elements()) {
+    if (item.type() != TLV_BATCH_ANSWER) {
+      if (ndn::tlv::isCriticalType(item.type())) {
+        NDN_THROW(std::runtime_error("Unrecognized TLV Type: " + std::to_string(item.type())));
+      }
+      continue;
+    }
+    BatchAnswer answer;
+    item.parse();
+    for (const auto& element : item.elements()) {
+      switch (element.type()) {
+        case ndn::tlv::Name:
+          answer.certName = Name(element);
+          break;
+        case ndn::tlv::Content:
+          answer.content = element;
+          break;
+        case TLV_BATCH_NACK:
+          break;
+        default:
+          if (ndn::tlv::isCriticalType(element.type())) {
+            NDN_THROW(std::runtime_error("Unrecognized TLV Type: " + std::to_string(element.type())));
+          }
+          break;
+      }
+    }
+    answers.push_back(std::move(answer));
+  }
+  return answers;
+}
+
+} // namespace cledger
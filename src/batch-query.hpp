@@ -0,0 +1,51 @@
+#ifndef CLEDGER_BATCH_QUERY_HPP
+#define CLEDGER_BATCH_QUERY_HPP
+
+#include "cledger-common.hpp"
+
+namespace cledger {
+
+/**
+ * @brief Certificates queried at once, sent as the ApplicationParameters of an
+ *        Interest for `<ledger prefix>/BATCH`.
+ */
+struct BatchQuery
+{
+  // up to MAX_BATCH_SIZE of them
+  std::vector<Name> certNames;
+  // inclusion proofs instead of descendant records
+  bool withProof = false;
+
+  static constexpr size_t MAX_BATCH_SIZE = 32;
+};
+
+Block
+encodeBatchQuery(const BatchQuery& query);
+
+BatchQuery
+decodeBatchQuery(const Block& block);
+
+/**
+ * @brief The answer about one certificate of a batch.
+ *
+ * The content is what a single RECORD or PROOF query about the certificate returns,
+ * and is not set when the ledger denies the certificate.
+ */
+struct BatchAnswer
+{
+  Name certName;
+  optional<Block> content;
+};
+
+/**
+ * @brief All answers of a batch, in the order of the query, as one block to segment.
+ */
+Block
+encodeBatchResponse(const std::vector<BatchAnswer>& answers);
+
+std::vector<BatchAnswer>
+decodeBatchResponse(const Block& block);
+
+} // namespace cledger
+
+#endif // CLEDGER_BATCH_QUERY_HPP
@@ -5,10 +5,12 @@ namespace cledger::checker {
 
 CheckerState::CheckerState(const Data& data,
                            const onSuccessCallback onSuccess, 
-                           const onFailureCallback onFailure)
+                           const onFailureCallback onFailure,
+                           bool withProof)
   : m_data(data)
   , m_sCb(onSuccess)
   , m_fCb(onFailure)
+  , m_withProof(withProof)
 {
 }
 
@@ -16,7 +18,7 @@ std::shared_ptr<Interest>
 CheckerState::makeInterest(const Name& ledgerPrefix)
 {
   Name interestName = m_data.getName();
-  interestName.set(-4, Name::Component("RECORD"));
+  interestName.set(-4, Name::Component(m_withProof ? "PROOF" : "RECORD"));
   auto interest = std::make_shared<Interest>(interestName);
   interest->setMustBeFresh(true);
   interest->setCanBePrefix(true);
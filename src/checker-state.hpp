@@ -4,6 +4,7 @@
 #include "record.hpp"
 #include "nack.hpp"
 #include "error.hpp"
+#include "util/segment/consumer.hpp"
 #include <ndn-cxx/security/key-chain.hpp>
 #include <ndn-cxx/face.hpp>
 #include <ndn-cxx/security/validator-config.hpp>
@@ -21,7 +22,8 @@ public:
   explicit
   CheckerState(const Data& data,
                const onSuccessCallback onSuccess, 
-               const onFailureCallback onFailure);
+               const onFailureCallback onFailure,
+               bool withProof = false);
   
   std::shared_ptr<Interest>
   makeInterest(const Name& ledgerPrefix);
@@ -32,6 +34,21 @@ public:
     return m_retryCount++ > CHECKER_MAX_RETRIES? true : false;
   }
 
+  const Data&
+  getData() const
+  {
+    return m_data;
+  }
+
+  /**
+   * @brief Whether the query asks for an inclusion proof instead of descendant records.
+   */
+  bool
+  withProof() const
+  {
+    return m_withProof;
+  }
+
   void
   onSuccess(const Block& block)
   {
@@ -44,11 +61,30 @@ public:
     return m_fCb(m_data, error);
   }
 
+  /**
+   * @brief Keep the consumer fetching the response of this check, or of its batch for
+   *        the first check of a batch, running until releaseConsumer().
+   */
+  void
+  setConsumer(std::shared_ptr<util::segment::Consumer> consumer)
+  {
+    m_consumer = std::move(consumer);
+  }
+
+  std::shared_ptr<util::segment::Consumer>
+  releaseConsumer()
+  {
+    return std::move(m_consumer);
+  }
+
 private:
   Data m_data;
   onSuccessCallback m_sCb;
   onFailureCallback m_fCb;
   ssize_t m_retryCount = 0;
+  bool m_withProof;
+  // its callback holds this state, released once the response is in
+  std::shared_ptr<util::segment::Consumer> m_consumer;
 };
 
 } // namespace cledger::checker
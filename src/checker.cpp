@@ -1,8 +1,16 @@
 #include "checker.hpp"
 #include "record.hpp"
 #include "error.hpp"
+#include "inclusion-proof.hpp"
+#include "batch-query.hpp"
+#include "util/merkle.hpp"
 #include "util/validate-multiple.hpp"
 #include <ndn-cxx/security/signing-helpers.hpp>
+
+#include <boost/asio/post.hpp>
+
+#include <map>
+
 namespace cledger::checker {
 
 #ifdef CLEDGER_WITH_BENCHMARK
@@ -14,16 +22,33 @@ NDN_LOG_INIT(cledger.checker);
 Checker::Checker(ndn::Face& face, ndn::security::Validator& validator)
   : m_face(face)
   , m_validator(validator)
-  , m_pipeline(std::make_shared<util::segment::PipelineInterestsFixed>(m_face, m_options))
 {
 }
 
+void
+Checker::fetchSegments(const std::shared_ptr<CheckerState>& checkerState, const Name& versionedName,
+                       const std::vector<Name>& forwardingHint, std::function<void(const Block&)> onContent)
+{
+  auto consumer = std::make_shared<util::segment::Consumer>(m_validator,
+    [this, checkerState, onContent = std::move(onContent)] (auto& block) {
+      // the consumer is still running this callback, it goes after it returns
+      boost::asio::post(m_face.getIoContext(), [consumer = checkerState->releaseConsumer()] {});
+      onContent(block);
+    }
+  );
+  checkerState->setConsumer(consumer);
+  util::segment::Options options;
+  options.forwardingHint = forwardingHint;
+  consumer->run(versionedName, std::make_shared<util::segment::PipelineInterestsFixed>(m_face, options));
+}
+
 void
 Checker::doCheck(const Name ledgerPrefix, const Data& data,
                  const onSuccessCallback onSuccess, 
-                 const onFailureCallback onFailure)
+                 const onFailureCallback onFailure,
+                 bool withProof)
 {
-  auto state = std::make_shared<CheckerState>(data, onSuccess, onFailure);
+  auto state = std::make_shared<CheckerState>(data, onSuccess, onFailure, withProof);
   dispatchInterest(state, ledgerPrefix);
 }
 
@@ -38,12 +63,12 @@ Checker::dispatchInterest(const std::shared_ptr<CheckerState>& checkerState,
   auto interest = checkerState->makeInterest(ledgerPrefix);
   NDN_LOG_INFO("Expressing Interest " << *interest << " ...");
   m_face.expressInterest(*interest,
-    [this, checkerState] (auto&&, auto& data) {
+    [this, checkerState, ledgerPrefix] (auto&&, auto& data) {
       // naming convention check
       m_validator.validate(data,
-        [this, checkerState, data] (const Data& d) {
+        [this, checkerState, ledgerPrefix, data] (const Data& d) {
         NDN_LOG_INFO("Data " << d.getName() << " conforms to trust schema");
-          return onValidationSuccess(checkerState, data);
+          return onValidationSuccess(checkerState, ledgerPrefix, data);
         },
         [this, checkerState, data] (const Data&, const ndn::security::ValidationError& error) {
           NDN_LOG_ERROR("Error authenticating data: " << error);
@@ -61,27 +86,14 @@ Checker::dispatchInterest(const std::shared_ptr<CheckerState>& checkerState,
 }
 
 void
-Checker::onValidationSuccess(const std::shared_ptr<CheckerState>& checkerState, const Data& data)
+Checker::onValidationSuccess(const std::shared_ptr<CheckerState>& checkerState,
+                             const Name& ledgerPrefix, const Data& data)
 {
   Name dataName = data.getName();
   if (dataName.get(-2).isVersion() && dataName.get(-3).toUri() == "data") {
-    // run segment consumer
-    m_consumer = std::make_shared<util::segment::Consumer>(m_validator, 
-      [this, checkerState] (auto& block) {
-        std::vector<Data> dataVector;
-        decodeContent(dataVector, block);
-        NDN_LOG_DEBUG(dataVector.size() << " Data were encapuslated");
-        util::validateMultipleData(m_validator, dataVector,
-          [checkerState, block] (auto& d) { 
-            checkerState->onSuccess(block);
-          },
-          [checkerState] (auto&&, auto& e) { 
-            checkerState->onFailure(Error(Error::Code::VALIDATION_ERROR, e.getInfo()));
-          }
-        );
-      }
-    );
-    m_consumer->run(dataName.getPrefix(-1), m_pipeline);
+    // the ledger serves the remaining segments of its response behind the same hint
+    fetchSegments(checkerState, dataName.getPrefix(-1), {ledgerPrefix},
+                  [this, checkerState] (const Block& block) { checkContent(checkerState, block); });
   }
   else if (Nack::isValidName(dataName)) {
     Nack nack;
@@ -93,12 +105,178 @@ Checker::onValidationSuccess(const std::shared_ptr<CheckerState>& checkerState,
   }
 }
 
+void
+Checker::checkContent(const std::shared_ptr<CheckerState>& checkerState, const Block& content)
+{
+  if (checkerState->withProof()) {
+    return verifyProof(checkerState, content);
+  }
+  std::vector<Data> dataVector;
+  decodeContent(dataVector, content);
+  NDN_LOG_DEBUG(dataVector.size() << " Data were encapuslated");
+  util::validateMultipleData(m_validator, dataVector,
+    [checkerState, content] (auto& d) { 
+      checkerState->onSuccess(content);
+    },
+    [checkerState] (auto&&, auto& e) { 
+      checkerState->onFailure(Error(Error::Code::VALIDATION_ERROR, e.getInfo()));
+    }
+  );
+}
+
+void
+Checker::doCheckMany(const Name ledgerPrefix, const std::vector<Data>& dataList,
+                     const onSuccessCallback onSuccess,
+                     const onFailureCallback onFailure,
+                     bool withProof)
+{
+  for (size_t first = 0; first < dataList.size(); first += BatchQuery::MAX_BATCH_SIZE) {
+    std::vector<std::shared_ptr<CheckerState>> checkerStates;
+    for (size_t i = first; i < std::min(dataList.size(), first + BatchQuery::MAX_BATCH_SIZE); i++) {
+      checkerStates.push_back(std::make_shared<CheckerState>(dataList[i], onSuccess, onFailure, withProof));
+    }
+    dispatchBatchInterest(checkerStates, ledgerPrefix, withProof);
+  }
+}
+
+void
+Checker::dispatchBatchInterest(const std::vector<std::shared_ptr<CheckerState>>& checkerStates,
+                               const Name& ledgerPrefix, bool withProof)
+{
+  auto failAll = [checkerStates] (const Error& error) {
+    for (const auto& checkerState : checkerStates) {
+      checkerState->onFailure(error);
+    }
+  };
+  // the batch shares one retry budget
+  if (checkerStates.front()->exhaustRetries()) {
+    return failAll(Error(Error::Code::TIMEOUT, "Running out of retries"));
+  }
+
+  BatchQuery batch;
+  for (const auto& checkerState : checkerStates) {
+    batch.certNames.push_back(checkerState->getData().getName());
+  }
+  batch.withProof = withProof;
+  Interest interest(Name(ledgerPrefix).append("BATCH"));
+  interest.setMustBeFresh(true);
+  interest.setCanBePrefix(true);
+  interest.setApplicationParameters(encodeBatchQuery(batch));
+
+  NDN_LOG_INFO("Expressing Batch Interest of " << batch.certNames.size() << " certificates ...");
+  m_face.expressInterest(interest,
+    [this, checkerStates, failAll] (auto&&, auto& data) {
+      m_validator.validate(data,
+        [this, checkerStates, failAll] (const Data& d) {
+          Name dataName = d.getName();
+          if (dataName.get(-2).isVersion() && dataName.get(-3).toUri() == "data") {
+            // the batch prefix is registered by the ledger, its segments need no hint;
+            // the first check of the batch holds the fetch, as it holds the retries
+            fetchSegments(checkerStates.front(), dataName.getPrefix(-1), {},
+                          [this, checkerStates] (const Block& block) { onBatchResponse(checkerStates, block); });
+          }
+          else if (Nack::isValidName(dataName)) {
+            failAll(Error(Error::Code::NACK, "Application Layer Nack " + dataName.toUri()));
+          }
+          else {
+            failAll(Error(Error::Code::PROTO_SPECIFIC, "Uncognized data format"));
+          }
+        },
+        [failAll] (const Data&, const ndn::security::ValidationError& error) {
+          NDN_LOG_ERROR("Error authenticating data: " << error);
+          failAll(Error(Error::Code::VALIDATION_ERROR, error.getInfo()));
+        }
+      );
+    },
+    [failAll] (auto& i, auto&&) {
+      failAll(Error(Error::Code::NACK, i.getName().toUri()));
+    },
+    [this, checkerStates, ledgerPrefix, withProof] (const auto&) {
+      dispatchBatchInterest(checkerStates, ledgerPrefix, withProof);
+    }
+  );
+}
+
+void
+Checker::onBatchResponse(const std::vector<std::shared_ptr<CheckerState>>& checkerStates, const Block& block)
+{
+  std::map<Name, Block> contents;
+  try {
+    for (auto& answer : decodeBatchResponse(block)) {
+      if (answer.content) {
+        contents.emplace(answer.certName, *answer.content);
+      }
+    }
+  }
+  catch (const std::exception& e) {
+    for (const auto& checkerState : checkerStates) {
+      checkerState->onFailure(Error(Error::Code::PROTO_SPECIFIC, e.what()));
+    }
+    return;
+  }
+
+  for (const auto& checkerState : checkerStates) {
+    auto it = contents.find(checkerState->getData().getName());
+    if (it == contents.end()) {
+      checkerState->onFailure(Error(Error::Code::NACK, "No answer for " + checkerState->getData().getName().toUri()));
+      continue;
+    }
+    checkContent(checkerState, it->second);
+  }
+}
+
 void
 Checker::onValidationFailure(const std::shared_ptr<CheckerState>& checkerState, const ndn::security::ValidationError& error)
 {
   return checkerState->onFailure(Error(Error::Code::VALIDATION_ERROR, error.getInfo()));
 }
 
+void
+Checker::verifyProof(const std::shared_ptr<CheckerState>& checkerState, const Block& content)
+{
+  optional<Data> treeHeadData;
+  optional<InclusionProof> proof;
+  try {
+    content.parse();
+    for (const auto &item : content.elements()) {
+      if (item.type() == ndn::tlv::Data) {
+        treeHeadData = Data(item);
+      }
+      else if (!proof) {
+        proof = decodeInclusionProof(item);
+      }
+    }
+  }
+  catch (const std::exception& e) {
+    return checkerState->onFailure(Error(Error::Code::PROTO_SPECIFIC, e.what()));
+  }
+  if (!treeHeadData || !proof) {
+    return checkerState->onFailure(Error(Error::Code::PROTO_SPECIFIC, "Incomplete inclusion proof"));
+  }
+
+  // a single signature to validate, the path is checked against the signed root
+  m_validator.validate(*treeHeadData,
+    [checkerState, proof = *proof, content] (const Data& d) {
+      TreeHead treeHead;
+      try {
+        treeHead = decodeTreeHead(d.getContent().blockFromValue());
+      }
+      catch (const std::exception& e) {
+        return checkerState->onFailure(Error(Error::Code::PROTO_SPECIFIC, e.what()));
+      }
+      auto leafHash = util::merkle::hashLeaf(checkerState->getData().getFullName().wireEncode());
+      if (proof.treeSize != treeHead.treeSize ||
+          !util::merkle::verifyInclusion(*leafHash, proof.leafIndex, proof.treeSize, proof.path, treeHead.root)) {
+        return checkerState->onFailure(Error(Error::Code::VALIDATION_ERROR, "Inclusion proof does not match the tree head"));
+      }
+      NDN_LOG_DEBUG("Leaf " << proof.leafIndex << " included in a tree of " << treeHead.treeSize);
+      checkerState->onSuccess(content);
+    },
+    [checkerState] (const Data&, const ndn::security::ValidationError& error) {
+      checkerState->onFailure(Error(Error::Code::VALIDATION_ERROR, error.getInfo()));
+    });
+}
+
 void
 Checker::decodeContent(std::vector<Data>& dataVector, const Block& content)
 {
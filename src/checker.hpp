@@ -16,29 +16,67 @@ public:
   explicit
   Checker(ndn::Face& face, ndn::security::Validator& validator);
 
+  /**
+   * @param withProof ask for a Merkle inclusion proof under a signed tree head, which
+   *        costs one signature validation, instead of the descendant records
+   */
   void
   doCheck(const Name ledgerPrefix, const Data& data,
           const onSuccessCallback onSuccess, 
-          const onFailureCallback onFailure);
+          const onFailureCallback onFailure,
+          bool withProof = false);
+
+  /**
+   * @brief Check several certificates with one query per BatchQuery::MAX_BATCH_SIZE of them.
+   *
+   * The callbacks are called once per certificate, as for doCheck().
+   */
+  void
+  doCheckMany(const Name ledgerPrefix, const std::vector<Data>& dataList,
+              const onSuccessCallback onSuccess,
+              const onFailureCallback onFailure,
+              bool withProof = false);
 
 private:
   void
   dispatchInterest(const std::shared_ptr<CheckerState>& checkerState,
                    const Name& ledgerPrefix);
   void
-  onValidationSuccess(const std::shared_ptr<CheckerState>& checkerState, const Data& data);
+  onValidationSuccess(const std::shared_ptr<CheckerState>& checkerState,
+                      const Name& ledgerPrefix, const Data& data);
+
+  void
+  dispatchBatchInterest(const std::vector<std::shared_ptr<CheckerState>>& checkerStates,
+                        const Name& ledgerPrefix, bool withProof);
+
+  void
+  onBatchResponse(const std::vector<std::shared_ptr<CheckerState>>& checkerStates, const Block& block);
+
+  /**
+   * @brief Verify the content answering one certificate, either records or an inclusion proof.
+   */
+  void
+  checkContent(const std::shared_ptr<CheckerState>& checkerState, const Block& content);
 
   void
   onValidationFailure(const std::shared_ptr<CheckerState>& checkerState, const ndn::security::ValidationError& error);
 
+  /**
+   * @brief Fetch the segments of @p versionedName behind @p forwardingHint, with a
+   *        consumer and pipeline held by @p checkerState alone.
+   */
+  void
+  fetchSegments(const std::shared_ptr<CheckerState>& checkerState, const Name& versionedName,
+                const std::vector<Name>& forwardingHint, std::function<void(const Block&)> onContent);
+
   void
   decodeContent(std::vector<Data>& dataVector, const Block& content);
 
+  void
+  verifyProof(const std::shared_ptr<CheckerState>& checkerState, const Block& content);
+
   ndn::Face& m_face;
   ndn::security::Validator& m_validator;
-  util::segment::Options m_options;
-  std::shared_ptr<util::segment::PipelineInterestsFixed> m_pipeline;
-  std::shared_ptr<util::segment::Consumer> m_consumer;
 };
 
 } // namespace cledger::checker
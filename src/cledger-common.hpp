@@ -76,6 +76,7 @@ enum : uint32_t {
   GENERIC_RECORD = 1,
   GENESIS_RECORD = 4,
   REPLY_RECORD = 5,
+  CHECKPOINT_RECORD = 6,
 };
 
 enum : uint32_t {
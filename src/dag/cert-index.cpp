@@ -0,0 +1,64 @@
+#include "dag/cert-index.hpp"
+
+namespace cledger::dag {
+
+enum : uint32_t {
+  TLV_CERT_INDEX_TYPE = 451,
+  TLV_CERT_INDEX_DIGEST = 452,
+  TLV_CERT_INDEX_STATE = 453,
+  TLV_CERT_INDEX_PROOF = 454,
+};
+
+Name
+toCertIndexName(const Name& certName)
+{
+  return Name(certIndexNameHeader).append(certName);
+}
+
+Block
+encodeCertIndexEntry(const CertIndexEntry& entry)
+{
+  Block block(TLV_CERT_INDEX_TYPE);
+  block.push_back(entry.certName.wireEncode());
+  block.push_back(ndn::makeBinaryBlock(TLV_CERT_INDEX_DIGEST, entry.digest.value_bytes()));
+  block.push_back(ndn::makeNestedBlock(TLV_CERT_INDEX_STATE, entry.stateName));
+  for (const auto& p : entry.proof) {
+    block.push_back(ndn::makeNestedBlock(TLV_CERT_INDEX_PROOF, p));
+  }
+  block.encode();
+  return block;
+}
+
+CertIndexEntry
+decodeCertIndexEntry(const Block& block)
+{
+  CertIndexEntry entry;
+  block.parse();
+  if (block.type() != TLV_CERT_INDEX_TYPE) {
+    NDN_THROW(std::runtime_error("TLV Type is incorrect"));
+  }
+  for (const auto &item : block.elements()) {
+    switch (item.type()) {
+      case ndn::tlv::Name:
+        entry.certName = Name(item);
+        break;
+      case TLV_CERT_INDEX_DIGEST:
+        entry.digest = Name::Component::fromImplicitSha256Digest(item.value_bytes());
+        break;
+      case TLV_CERT_INDEX_STATE:
+        entry.stateName = Name(item.blockFromValue());
+        break;
+      case TLV_CERT_INDEX_PROOF:
+        entry.proof.emplace_back(item.blockFromValue());
+        break;
+      default:
+        if (ndn::tlv::isCriticalType(item.type())) {
+          NDN_THROW(std::runtime_error("Unrecognized TLV Type: " + std::to_string(item.type())));
+        }
+        break;
+    }
+  }
+  return entry;
+}
+
+} // namespace cledger::dag
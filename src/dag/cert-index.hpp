@@ -0,0 +1,40 @@
+#ifndef CLEDGER_DAG_CERT_INDEX_HPP
+#define CLEDGER_DAG_CERT_INDEX_HPP
+
+#include "cledger-common.hpp"
+
+namespace cledger::dag {
+
+const std::string certIndexNameHeader = "/32=CertIndex";
+// the certificate filter, saved at shutdown
+const std::string certFilterName = "/32=CertFilter";
+
+/**
+ * @brief Secondary index from a certificate Name to its EdgeState, written at ingest.
+ *
+ * A record query reads this one entry instead of the certificate, its PayloadMap and
+ * its EdgeState. The implicit digest of the certificate is kept so that proof queries
+ * need not rehash it either. The proof lists the descendants the interlock policy
+ * selected, and is filled in once the record is interlocked.
+ */
+struct CertIndexEntry
+{
+  Name certName;
+  // implicit SHA-256 digest of the certificate Data
+  Name::Component digest;
+  Name stateName;
+  std::vector<Name> proof;
+};
+
+Name
+toCertIndexName(const Name& certName);
+
+Block
+encodeCertIndexEntry(const CertIndexEntry& entry);
+
+CertIndexEntry
+decodeCertIndexEntry(const Block& block);
+
+} // namespace cledger::dag
+
+#endif // CLEDGER_DAG_CERT_INDEX_HPP
@@ -0,0 +1,222 @@
+#include "dag/dag-journal.hpp"
+
+#include <algorithm>
+
+namespace cledger::dag {
+NDN_LOG_INIT(cledger.dag.journal);
+
+enum : uint32_t {
+  TLV_DAG_JOURNAL_SEGMENT = 391,
+  TLV_DAG_JOURNAL_ENTRY = 392,
+  TLV_DAG_JOURNAL_OP = 393,
+  TLV_DAG_JOURNAL_MISSING = 394,
+  TLV_DAG_JOURNAL_HEAD = 395,
+  TLV_DAG_JOURNAL_FIRST = 396,
+};
+
+// entries per segment when rewriting a snapshot
+const size_t SNAPSHOT_SEGMENT_ENTRIES = 1024;
+
+static Name
+toSegmentName(uint64_t segment)
+{
+  return Name(journalNameHeader).appendNumber(segment);
+}
+
+static Name
+toHeadName()
+{
+  return Name(journalNameHeader).append("head");
+}
+
+DagJournal::DagJournal(storage::Interface storageIntf, size_t compactThreshold)
+  : m_storageIntf(storageIntf)
+  , m_compactThreshold(compactThreshold)
+{
+}
+
+DagJournal::Snapshot
+DagJournal::load()
+{
+  Snapshot snapshot;
+  m_buffer.clear();
+  m_journaled = 0;
+  m_first = 0;
+  try {
+    auto head = m_storageIntf.getter(toHeadName());
+    head.parse();
+    m_first = ndn::readNonNegativeInteger(head.get(TLV_DAG_JOURNAL_FIRST));
+  }
+  catch (const std::exception& e) {
+    NDN_LOG_DEBUG("No DAG journal to load");
+  }
+
+  // segments are contiguous, the first one missing ends the journal
+  for (m_next = m_first; ; m_next++) {
+    Block segment;
+    try {
+      segment = m_storageIntf.getter(toSegmentName(m_next));
+    }
+    catch (const std::exception& e) {
+      break;
+    }
+    segment.parse();
+    if (segment.type() != TLV_DAG_JOURNAL_SEGMENT) {
+      NDN_THROW(std::runtime_error("TLV Type is incorrect"));
+    }
+    for (const auto& item : segment.elements()) {
+      if (item.type() != TLV_DAG_JOURNAL_ENTRY) {
+        continue;
+      }
+      item.parse();
+      Entry entry;
+      entry.op = static_cast<Entry::Op>(ndn::readNonNegativeInteger(item.get(TLV_DAG_JOURNAL_OP)));
+      entry.stateName = Name(item.get(ndn::tlv::Name));
+      auto missing = item.find(TLV_DAG_JOURNAL_MISSING);
+      if (missing != item.elements_end()) {
+        entry.missing = Name(missing->blockFromValue());
+      }
+      apply(entry, snapshot);
+      m_journaled++;
+    }
+  }
+  NDN_LOG_INFO("Loaded DAG journal segments [" << m_first << ", " << m_next << "): "
+               << snapshot.frontier.size() << " pending states, "
+               << snapshot.pending.size() << " missing states, "
+               << snapshot.epoch.size() << " states in the epoch");
+  return snapshot;
+}
+
+void
+DagJournal::enter(const Name& stateName)
+{
+  m_buffer.push_back({Entry::ENTER, stateName, Name()});
+}
+
+void
+DagJournal::leave(const Name& stateName)
+{
+  m_buffer.push_back({Entry::LEAVE, stateName, Name()});
+}
+
+void
+DagJournal::wait(const Name& missing, const Name& stateName)
+{
+  m_buffer.push_back({Entry::WAIT, stateName, missing});
+}
+
+void
+DagJournal::resolve(const Name& missing)
+{
+  m_buffer.push_back({Entry::RESOLVE, Name(), missing});
+}
+
+void
+DagJournal::checkpoint(const Name& checkpointName)
+{
+  m_buffer.push_back({Entry::CHECKPOINT, checkpointName, Name()});
+}
+
+void
+DagJournal::flush()
+{
+  if (m_buffer.empty()) {
+    return;
+  }
+  Block segment(TLV_DAG_JOURNAL_SEGMENT);
+  for (auto& entry : m_buffer) {
+    Block item(TLV_DAG_JOURNAL_ENTRY);
+    item.push_back(ndn::makeNonNegativeIntegerBlock(TLV_DAG_JOURNAL_OP, entry.op));
+    item.push_back(entry.stateName.wireEncode());
+    if (!entry.missing.empty()) {
+      item.push_back(ndn::makeNestedBlock(TLV_DAG_JOURNAL_MISSING, entry.missing));
+    }
+    item.encode();
+    segment.push_back(item);
+  }
+  segment.encode();
+  m_storageIntf.adder(toSegmentName(m_next++), segment);
+  m_journaled += m_buffer.size();
+  m_buffer.clear();
+}
+
+void
+DagJournal::compact(const Snapshot& live)
+{
+  m_buffer.clear();
+  m_journaled = 0;
+  uint64_t oldFirst = m_first;
+  uint64_t oldNext = m_next;
+  m_first = m_next;
+
+  auto flushIfFull = [this] {
+    if (m_buffer.size() >= SNAPSHOT_SEGMENT_ENTRIES) {
+      flush();
+    }
+  };
+  // the epoch is reset and rewritten in a single segment, so that replaying it
+  // after the old segments neither duplicates nor truncates the epoch
+  checkpoint(live.lastCheckpoint);
+  for (auto& s : live.epoch) {
+    leave(s);
+  }
+  flush();
+  for (auto& s : live.frontier) {
+    enter(s);
+    flushIfFull();
+  }
+  for (auto& p : live.pending) {
+    for (auto& s : p.second) {
+      wait(p.first, s);
+      flushIfFull();
+    }
+  }
+  flush();
+
+  // entering and waiting are idempotent, so the snapshot replays to the same state
+  // even after the old segments, and a crash before this point only costs a longer load
+  writeHead();
+  for (auto i = oldFirst; i < oldNext; i++) {
+    m_storageIntf.deleter(toSegmentName(i));
+  }
+  NDN_LOG_DEBUG("Compacted DAG journal into segments [" << m_first << ", " << m_next << ")");
+}
+
+void
+DagJournal::apply(const Entry& entry, Snapshot& snapshot)
+{
+  switch (entry.op) {
+    case Entry::ENTER:
+      snapshot.frontier.insert(entry.stateName);
+      break;
+    case Entry::LEAVE:
+      snapshot.frontier.erase(entry.stateName);
+      snapshot.epoch.push_back(entry.stateName);
+      break;
+    case Entry::WAIT: {
+      auto& waiting = snapshot.pending[entry.missing];
+      if (std::find(waiting.begin(), waiting.end(), entry.stateName) == waiting.end()) {
+        waiting.push_back(entry.stateName);
+      }
+      break;
+    }
+    case Entry::RESOLVE:
+      snapshot.pending.erase(entry.missing);
+      break;
+    case Entry::CHECKPOINT:
+      snapshot.lastCheckpoint = entry.stateName;
+      snapshot.epoch.clear();
+      break;
+  }
+}
+
+void
+DagJournal::writeHead()
+{
+  Block head(TLV_DAG_JOURNAL_HEAD);
+  head.push_back(ndn::makeNonNegativeIntegerBlock(TLV_DAG_JOURNAL_FIRST, m_first));
+  head.encode();
+  m_storageIntf.replacer(toHeadName(), head);
+}
+
+} // namespace cledger::dag
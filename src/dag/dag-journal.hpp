@@ -0,0 +1,118 @@
+#ifndef CLEDGER_DAG_DAG_JOURNAL_HPP
+#define CLEDGER_DAG_DAG_JOURNAL_HPP
+
+#include "cledger-common.hpp"
+#include "storage/ledger-storage.hpp"
+namespace cledger::dag {
+
+const std::string journalNameHeader = "/32=DagJournal";
+
+/**
+ * @brief Journal of the in-memory DAG frontier, kept in the ledger storage.
+ *
+ * The edge states are stored anyway, but the waitlist (states not interlocked
+ * yet), the records waiting on missing parents and the states interlocked since
+ * the last epoch checkpoint only live in DagModule. Their
+ * changes are appended to the journal and flushed as numbered segments
+ * /32=DagJournal/<n>; the head object only records the first live segment,
+ * so a flush is a single write. Once the journal outgrows the live frontier,
+ * it is rewritten as a snapshot and the old segments are dropped.
+ */
+class DagJournal
+{
+public:
+  struct Snapshot
+  {
+    // states in the waitlist
+    std::set<Name> frontier;
+    // missing state -> loaded states waiting on it, in arrival order
+    std::map<Name, std::vector<Name>> pending;
+    // states interlocked since the last checkpoint, in order
+    std::vector<Name> epoch;
+    Name lastCheckpoint;
+  };
+
+  explicit
+  DagJournal(storage::Interface storageIntf, size_t compactThreshold = 4096);
+
+  /**
+   * @brief Replay the stored journal; appends continue after its last segment.
+   */
+  Snapshot
+  load();
+
+  void
+  enter(const Name& stateName);
+
+  /**
+   * @brief The state is interlocked, it leaves the waitlist and joins the epoch.
+   */
+  void
+  leave(const Name& stateName);
+
+  void
+  wait(const Name& missing, const Name& stateName);
+
+  void
+  resolve(const Name& missing);
+
+  /**
+   * @brief The epoch is closed by the given checkpoint.
+   */
+  void
+  checkpoint(const Name& checkpointName);
+
+  /**
+   * @brief Write the buffered entries as one segment.
+   */
+  void
+  flush();
+
+  /**
+   * @brief Whether the stored entries clearly outnumber a frontier of @p liveEntries.
+   */
+  bool
+  needsCompaction(size_t liveEntries) const
+  {
+    return m_journaled + m_buffer.size() > 2 * liveEntries + m_compactThreshold;
+  }
+
+  /**
+   * @brief Replace the journal by the given live state.
+   */
+  void
+  compact(const Snapshot& live);
+
+CLEDGER_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  struct Entry
+  {
+    enum Op {
+      ENTER = 0,
+      LEAVE = 1,
+      WAIT = 2,
+      RESOLVE = 3,
+      CHECKPOINT = 4,
+    };
+    Op op;
+    Name stateName;
+    Name missing;
+  };
+
+  static void
+  apply(const Entry& entry, Snapshot& snapshot);
+
+  void
+  writeHead();
+
+  storage::Interface m_storageIntf;
+  size_t m_compactThreshold;
+  std::vector<Entry> m_buffer;
+  // live segments are [m_first, m_next)
+  uint64_t m_first = 0;
+  uint64_t m_next = 0;
+  size_t m_journaled = 0;
+};
+
+} // namespace cledger::dag
+
+#endif // CLEDGER_DAG_DAG_JOURNAL_HPP
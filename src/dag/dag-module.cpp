@@ -1,107 +1,181 @@
 #include "dag/dag-module.hpp"
 #include "dag/edge-state-list.hpp"
 
+#include <algorithm>
+
 namespace cledger::dag {
 NDN_LOG_INIT(cledger.dag);
 
+// interlocked states are never traversed nor evaluated again
+static bool
+isSettled(const EdgeState& state)
+{
+  return state.status == EdgeState::INTERLOCKED || state.status == EdgeState::CHECKPOINTED;
+}
+
 DagModule::DagModule(storage::Interface storageIntf, policy::Interface policyIntf)
  : m_storageIntf(storageIntf)
+ , m_interner(std::make_shared<NameInterner>(storageIntf))
  , m_policyIntf(policyIntf)
+ , m_policy(policy::DynamicPolicy(policyIntf))
+ , m_journal(storageIntf)
+ , m_arenaBuffer(std::make_unique<std::byte[]>(ARENA_BUFFER_SIZE))
 {
 }
 
-Name
-DagModule::add(const Record& record)
+DagModule::DagModule(storage::Interface storageIntf, policy::InterlockPolicy& policy)
+ : m_storageIntf(storageIntf)
+ , m_interner(std::make_shared<NameInterner>(storageIntf))
+ , m_policyIntf(policy.getInterface())
+ , m_policy(policy::makePolicyDispatch(policy))
+ , m_journal(storageIntf)
+ , m_arenaBuffer(std::make_unique<std::byte[]>(ARENA_BUFFER_SIZE))
 {
-  auto state = getOrConstruct(toStateName(record.getName()));
-  state.record = record;
-  switch (state.status) {
-    case EdgeState::INITIALIZED:
-      onNewRecord(state);
-      return state.stateName;
-    case EdgeState::LOADED:
-    case EdgeState::INTERLOCKED:
-      // duplicate, reject
-      return state.stateName;
-    default:
-      break;
-  }
-  return state.stateName;
-}
-
-std::list<Name>
-DagModule::getAncestors(EdgeState state) 
-{
-  std::list<Name> ret;
-  std::vector<Name> ancestors;
-  // every frontier must be expandable (ie. not a pending record)
-  std::vector<Name> frontier;
-  std::vector<Name> nextFrontier;
-  uint32_t prevAncestors = 0;
-  uint32_t currAncestors = 0;
-  // the oldest being the first
+  // one ID per state across the DAG and the policy caches
+  if (auto witness = std::get_if<policy::InterlockPolicyWitness*>(&m_policy)) {
+    (*witness)->setInterner(m_interner);
+  }
+}
 
-  // start
-  for (auto& ptr : state.record.getPointers()) {
-    auto parent = getOrConstruct(toStateName(ptr));
-    if (parent.status != EdgeState::INTERLOCKED) {
-      ancestors.push_back(parent.stateName);
+void
+DagModule::restore()
+{
+  auto snapshot = m_journal.load();
+  m_waitlist.clear();
+  m_pending.clear();
+  for (auto& p : snapshot.pending) {
+    auto& blocked = m_pending[m_interner->intern(p.first)];
+    for (auto& n : p.second) {
+      blocked.push_back(m_interner->intern(n));
     }
-    // if this is pending, update its descendents
-    if (parent.status == EdgeState::INITIALIZED) {
-      NDN_LOG_TRACE(parent.stateName << " is a pending ancestor, stop here...\n"
-                    "Adding " << state.stateName << "into descendants..");
-      parent.descendants.insert(state.stateName);
-      update(parent);
+  }
+  m_epoch.clear();
+  for (auto& s : snapshot.epoch) {
+    m_epoch.push_back(m_interner->intern(s));
+  }
+  m_lastEpoch = snapshot.lastCheckpoint.empty() ? 0 : fromCheckpointName(snapshot.lastCheckpoint);
+
+  std::vector<EdgeState> window;
+  for (auto& s : snapshot.frontier) {
+    auto state = find(s);
+    if (state && state->status == EdgeState::LOADED) {
+      window.push_back(std::move(*state));
     }
-    else if (parent.status != EdgeState::INTERLOCKED) {
-      // we gonna expand this ptr in the next round.
-      frontier.push_back(parent.stateName);
+  }
+  if (m_policyIntf.batchEvaluater) {
+    for (auto& score : m_policyIntf.batchEvaluater(window)) {
+      m_waitlist[score.second].insert(m_interner->intern(score.first));
     }
   }
-  currAncestors = ancestors.size();
-  // interation
-  while (currAncestors > prevAncestors)
-  {
-    nextFrontier.clear();
-    for (auto& f : frontier) {
-      for (auto& ptr : getOrConstruct(f).record.getPointers()) {
-        auto parent = getOrConstruct(toStateName(ptr));
-
-        // add to ancestor?
-        bool hasSeen = false;
-        for (auto& a : ancestors) {
-          if (a == parent.stateName) {
-            hasSeen = true;
-            break;
-          }
-        }
-        if (!hasSeen && parent.status != EdgeState::INTERLOCKED) {
-          ancestors.push_back(parent.stateName);
-        }
-
-        if (parent.status == EdgeState::INITIALIZED) {
-          NDN_LOG_TRACE(parent.stateName << " is a pending state, stop here...\n"
-                        "Adding " << state.stateName << " into descendants..");
-          parent.descendants.insert(state.stateName);
-          update(parent);
-        }
-        else if (parent.status != EdgeState::INTERLOCKED) {
-          nextFrontier.push_back(parent.stateName);
-        }
+  else {
+    policy::visitPolicy(m_policy, [&] (auto& policy) {
+      for (auto& state : window) {
+        m_waitlist[policy.evaluate(state)].insert(m_interner->intern(state.stateName));
       }
+    });
+  }
+  NDN_LOG_INFO("Restored " << window.size() << " pending states, "
+               << m_pending.size() << " missing states");
+}
+
+std::set<Name>
+DagModule::getWaitList(const uint32_t value)
+{
+  std::set<Name> ret;
+  auto l = m_waitlist.find(value);
+  if (l != m_waitlist.end()) {
+    for (auto id : l->second) {
+      ret.insert(m_interner->lookup(id));
     }
-    prevAncestors = currAncestors;
-    currAncestors = ancestors.size();
-    frontier = nextFrontier;
   }
+  return ret;
+}
 
-  for (auto& a : ancestors) {
-    ret.push_front(a);
+std::map<const uint32_t, std::set<Name>>
+DagModule::getWaitList()
+{
+  std::map<const uint32_t, std::set<Name>> ret;
+  for (auto& l : m_waitlist) {
+    auto& names = ret[l.first];
+    for (auto id : l.second) {
+      names.insert(m_interner->lookup(id));
+    }
   }
   return ret;
 }
 
+Name
+DagModule::add(const Record& record)
+{
+  auto stateName = toStateName(record.getName());
+  auto stored = find(stateName);
+  if (stored && stored->status != EdgeState::INITIALIZED) {
+    // duplicate, reject
+    return stateName;
+  }
+
+  // INITIALIZED placeholders can only be left in storage by older versions
+  auto state = stored ? *stored : construct(stateName);
+  state.record = record;
+  state.status = EdgeState::LOADED;
+  if (stored) {
+    update(state);
+  }
+  else {
+    m_storageIntf.adder(state.stateName, encodeEdgeState(state));
+  }
+  {
+    // transient traversal state of this round, released in one shot
+    std::pmr::monotonic_buffer_resource arena(m_arenaBuffer.get(), ARENA_BUFFER_SIZE, m_arenaUpstream);
+    policy::visitPolicy(m_policy, [&] (auto& policy) { onNewRecord(policy, state, &arena); });
+  }
+  if (m_policyIntf.batchEvaluater && ++m_addedSinceWindow >= m_batchWindow) {
+    evaluateWindow();
+  }
+  commitJournal();
+  return stateName;
+}
+
+std::pmr::deque<EdgeState>
+DagModule::getAncestors(const EdgeState& state, std::pmr::set<Name>& missing,
+                        std::pmr::memory_resource* arena)
+{
+  // breadth-first, the ancestors double as the queue and the frontier is a position
+  // in it, so every state met is read and expanded only once
+  std::pmr::deque<EdgeState> ancestors(arena);
+  std::pmr::set<Name> seen(arena);
+  seen.insert(state.stateName);
+
+  auto visit = [&] (const Name& ptr) {
+    auto stateName = toStateName(ptr);
+    if (!seen.insert(stateName).second) {
+      return;
+    }
+    auto parent = find(stateName);
+    if (!parent) {
+      NDN_LOG_TRACE(stateName << " is a missing ancestor, stop here...");
+      missing.insert(std::move(stateName));
+    }
+    else if (!isSettled(*parent)) {
+      ancestors.push_back(std::move(*parent));
+    }
+  };
+
+  for (auto& ptr : state.record.getPointers()) {
+    visit(ptr);
+  }
+  for (size_t i = 0; i < ancestors.size(); i++) {
+    // push_back on a deque keeps references to the elements valid
+    for (auto& ptr : ancestors[i].record.getPointers()) {
+      visit(ptr);
+    }
+  }
+
+  // the oldest being the first
+  std::reverse(ancestors.begin(), ancestors.end());
+  return ancestors;
+}
+
 std::list<Record>
 DagModule::harvestBelow(const uint32_t threshold)
 {
@@ -109,8 +183,8 @@ DagModule::harvestBelow(const uint32_t threshold)
   std::list<Name> stateNames;
   for (auto& map : m_waitlist) {
     if (map.first < threshold)  {
-      for (auto& s : map.second) {
-        auto state = getOrConstruct(s);
+      for (auto s : map.second) {
+        auto state = getOrConstruct(m_interner->lookup(s));
         if (state.status != EdgeState::INITIALIZED) {
           ret.push_back(state.record);
         }
@@ -125,104 +199,337 @@ DagModule::harvestAbove(const uint32_t threshold, bool remove)
 {
   std::list<Record> ret;
   for (auto& map : m_waitlist) {
-    std::list<Name> rm;
+    std::list<NameId> rm;
     if (map.first >= threshold)  {
-      for (auto& s : map.second) {
-        auto state = getOrConstruct(s);
+      for (auto s : map.second) {
+        auto state = getOrConstruct(m_interner->lookup(s));
         if (state.status != EdgeState::INITIALIZED) {
           ret.push_back(state.record);
+          if (state.status != EdgeState::INTERLOCKED) {
+            state.interlocked = time::system_clock::now();
+            m_journal.leave(state.stateName);
+            m_epoch.push_back(s);
+          }
           state.status = EdgeState::INTERLOCKED;
           update(state);
+          policy::visitPolicy(m_policy, [&] (auto& policy) { policy.release(state.stateName); });
           if (remove) rm.push_back(s);
         }
       }
       for (auto& n : rm) map.second.erase(n);
     }
   }
+  commitJournal();
   return ret;
 }
 
+optional<EpochCheckpoint>
+DagModule::checkpoint(size_t keepDescendants)
+{
+  if (m_epoch.empty()) {
+    return nullopt;
+  }
+
+  EpochCheckpoint checkpoint;
+  checkpoint.epoch = m_lastEpoch + 1;
+  checkpoint.checkpointName = toCheckpointName(checkpoint.epoch);
+  for (auto s : m_epoch) {
+    checkpoint.records.push_back(fromStateName(m_interner->lookup(s)));
+  }
+  checkpoint.size = checkpoint.records.size();
+  checkpoint.root = computeCheckpointRoot(checkpoint.records);
+  m_storageIntf.adder(checkpoint.checkpointName, encodeEpochCheckpoint(checkpoint));
+  NDN_LOG_DEBUG("Checkpointing epoch " << checkpoint.epoch << " with " << checkpoint.size << " records");
+
+  std::set<NameId> epoch(m_epoch.begin(), m_epoch.end());
+  for (auto s : m_epoch) {
+    auto state = find(m_interner->lookup(s));
+    if (!state || state->status != EdgeState::INTERLOCKED) {
+      continue;
+    }
+    auto proof = policy::visitPolicy(m_policy, [&] (auto& policy) { return policy.select(*state); });
+    state->descendants.clear();
+    for (auto& d : proof) {
+      if (state->descendants.size() >= keepDescendants) {
+        break;
+      }
+      state->descendants.insert(d);
+    }
+    state->status = EdgeState::CHECKPOINTED;
+    update(*state);
+  }
+  // harvests without removal may have left them in the waitlist
+  for (auto& l : m_waitlist) {
+    for (auto it = l.second.begin(); it != l.second.end();) {
+      it = epoch.count(*it) > 0 ? l.second.erase(it) : std::next(it);
+    }
+  }
+
+  m_journal.checkpoint(checkpoint.checkpointName);
+  m_lastEpoch = checkpoint.epoch;
+  m_epoch.clear();
+  commitJournal();
+  return checkpoint;
+}
+
+std::vector<EdgeState>
+DagModule::getTips()
+{
+  std::vector<EdgeState> ret;
+  for (auto s : m_waitlist[0]) {
+    auto state = find(m_interner->lookup(s));
+    if (state && state->status != EdgeState::INITIALIZED) {
+      ret.push_back(std::move(*state));
+    }
+  }
+  return ret;
+}
+
+void
+DagModule::evaluateWindow()
+{
+  if (!m_policyIntf.batchEvaluater) {
+    return;
+  }
+
+  // descendants of a pending state are pending too, they come after it
+  std::vector<EdgeState> window;
+  std::set<NameId> seen;
+  std::deque<NameId> queue(m_recent.begin(), m_recent.end());
+  m_recent.clear();
+  m_addedSinceWindow = 0;
+  while (!queue.empty()) {
+    auto id = queue.front();
+    queue.pop_front();
+    if (!seen.insert(id).second) {
+      continue;
+    }
+    auto state = find(m_interner->lookup(id));
+    if (!state || state->status != EdgeState::LOADED) {
+      continue;
+    }
+    for (auto& d : state->descendants) {
+      queue.push_back(m_interner->intern(d));
+    }
+    window.push_back(std::move(*state));
+  }
+  NDN_LOG_TRACE("Batch evaluating " << window.size() << " pending states");
+  for (auto& score : m_policyIntf.batchEvaluater(window)) {
+    auto id = m_interner->intern(score.first);
+    for (auto& l : m_waitlist) {
+      l.second.erase(id);
+    }
+    m_waitlist[score.second].insert(id);
+  }
+}
+
+void
+DagModule::setBatchEvaluater(policy::BatchEvaluater evaluater, size_t window)
+{
+  m_policyIntf.batchEvaluater = std::move(evaluater);
+  m_batchWindow = std::max<size_t>(window, 1);
+  m_recent.clear();
+  m_addedSinceWindow = 0;
+}
+
 EdgeState
-DagModule::getOrConstruct(const Name& name)
+DagModule::construct(const Name& name)
+{
+  EdgeState s;
+  s.stateName = Name(name);
+  s.status = EdgeState::INITIALIZED;
+  s.created = time::system_clock::now() + 1_ns;
+  s.interlocked = time::system_clock::now();
+  return s;
+}
+
+optional<EdgeState>
+DagModule::find(const Name& name)
 {
-  auto construct = [] (const Name& n) {
-    EdgeState s;
-    s.stateName = Name(n);
-    s.status = EdgeState::INITIALIZED;
-    s.created = time::system_clock::now() + 1_ns;
-    s.interlocked = time::system_clock::now();
-    return s;
-  };
   try {
     auto block = m_storageIntf.getter(name);
     return decodeEdgeState(block);
   }
-  catch (std::exception& e) {
-    auto s = construct(name);
-    m_storageIntf.adder(s.stateName, encodeEdgeState(s));
-    return s;
+  catch (const std::exception& e) {
+    return nullopt;
   }
 }
 
+EdgeState
+DagModule::getOrConstruct(const Name& name)
+{
+  auto state = find(name);
+  if (state) {
+    return *state;
+  }
+  auto s = construct(name);
+  m_storageIntf.adder(s.stateName, encodeEdgeState(s));
+  return s;
+}
+
 void
 DagModule::update(EdgeState state)
 {
-  m_storageIntf.deleter(state.stateName);
-  m_storageIntf.adder(state.stateName, encodeEdgeState(state));
+  // in one step, queries may read the state from another thread
+  m_storageIntf.replacer(state.stateName, encodeEdgeState(state));
 }
 
+template<class Policy>
 DagModule&
-DagModule::onNewRecord(EdgeState& state)
+DagModule::onNewRecord(Policy& policy, EdgeState& state, std::pmr::memory_resource* arena)
 {
   NDN_LOG_TRACE("Processing EdgeState " << state.stateName);
-  state.status = EdgeState::LOADED;
-  update(state);
-  evaluateWaitlist(state);
-  // if this is not a genesis record
-  if (!state.record.isGenesis()) {
-    evaluateAncestors(state);
-  }
 
-  // resolve all pending descendants
+  // records that arrived before this one and wait on it; they are not in any
+  // particular order, and need not be: each only gains this state's descendants
+  // (set inserts) and the evaluation below sees the complete set at once
+  std::vector<Name> waiting;
+  auto pending = m_pending.find(m_interner->intern(state.stateName));
+  if (pending != m_pending.end()) {
+    for (auto w : pending->second) {
+      waiting.push_back(m_interner->lookup(w));
+    }
+    m_pending.erase(pending);
+    m_journal.resolve(state.stateName);
+  }
+  // descendants kept by a legacy placeholder
   for (auto& desc : state.descendants) {
-    auto descState = getOrConstruct(desc);
-    // if this is a genesis record
-    NDN_LOG_TRACE("Resolving pending descendants " << descState.stateName);
-    if (!descState.record.isGenesis()) {
-      evaluateAncestors(descState);
+    if (std::find(waiting.begin(), waiting.end(), desc) == waiting.end()) {
+      waiting.push_back(desc);
     }
   }
+
+  if (!waiting.empty()) {
+    NDN_LOG_TRACE("Resolving " << waiting.size() << " pending descendants");
+    for (auto& w : waiting) {
+      addDescendant(policy, state, w);
+    }
+    update(state);
+  }
+  evaluateWaitlist(policy, state);
+
+  // if this is not a genesis record
+  if (!state.record.isGenesis()) {
+    evaluateAncestors(policy, state, waiting, arena);
+  }
   return *this;
 }
 
+template<class Policy>
 void
-DagModule::evaluateAncestors(EdgeState& state)
+DagModule::evaluateAncestors(Policy& policy, EdgeState& state, const std::vector<Name>& waiting,
+                             std::pmr::memory_resource* arena)
 {
   NDN_LOG_TRACE("Checking ancestors for " << state.stateName);
-  auto ancestors = getAncestors(state);
-  for (auto& a : ancestors) {
-    auto aState = getOrConstruct(a);
-    NDN_LOG_TRACE("Adding a descendant " << state.stateName << " for " << a
+  std::pmr::set<Name> missing(arena);
+  // already read by the traversal, and each ancestor is only updated once below
+  auto ancestors = getAncestors(state, missing, arena);
+  for (auto& aState : ancestors) {
+    NDN_LOG_TRACE("Adding a descendant " << state.stateName << " for " << aState.stateName
                   << ", current descendant size is " << aState.descendants.size());
-    aState.descendants.insert(state.stateName);
+    addDescendant(policy, aState, state.stateName);
+    for (auto& w : waiting) {
+      addDescendant(policy, aState, w);
+    }
     update(aState);
-    evaluateWaitlist(aState);
+    evaluateWaitlist(policy, aState);
+  }
+
+  // what is still missing above this state also blocks the records waiting on it
+  for (auto& m : missing) {
+    auto& blocked = m_pending[m_interner->intern(m)];
+    auto enqueue = [this, &blocked, &m] (const Name& n) {
+      auto id = m_interner->intern(n);
+      if (std::find(blocked.begin(), blocked.end(), id) == blocked.end()) {
+        blocked.push_back(id);
+        m_journal.wait(m, n);
+      }
+    };
+    enqueue(state.stateName);
+    for (auto& w : waiting) {
+      enqueue(w);
+    }
   }
 }
 
+template<class Policy>
 void
-DagModule::evaluateWaitlist(EdgeState& state)
+DagModule::addDescendant(Policy& policy, EdgeState& state, const Name& descendant)
+{
+  if (state.descendants.insert(descendant).second) {
+    policy.track(state, descendant);
+  }
+}
+
+template<class Policy>
+void
+DagModule::evaluateWaitlist(Policy& policy, EdgeState& state)
 {
   NDN_LOG_TRACE("Evaluating waitlist for " << state.stateName);
 
-  if (state.status == EdgeState::INTERLOCKED) return;
+  if (isSettled(state)) return;
+
+  auto id = m_interner->intern(state.stateName);
+  if (m_policyIntf.batchEvaluater) {
+    // scored by the next evaluateWindow(), a new state waits unscored until then
+    m_recent.push_back(id);
+    for (auto& l : m_waitlist) {
+      if (l.second.count(id) > 0) {
+        return;
+      }
+    }
+    m_waitlist[0].insert(id);
+    m_journal.enter(state.stateName);
+    return;
+  }
 
+  bool isNew = true;
   for (auto& l : m_waitlist) {
-    auto prev = l.second.find(state.stateName);
-    if (prev != l.second.end()) {
-      l.second.erase(state.stateName);
+    if (l.second.erase(id) > 0) {
+      isNew = false;
+    }
+  }
+  m_waitlist[policy.evaluate(state)].insert(id);
+  if (isNew) {
+    m_journal.enter(state.stateName);
+  }
+}
+
+void
+DagModule::commitJournal()
+{
+  // IDs first, the journal itself holds Names
+  m_interner->flush();
+  m_journal.flush();
+
+  size_t live = 0;
+  for (auto& l : m_waitlist) {
+    live += l.second.size();
+  }
+  for (auto& p : m_pending) {
+    live += p.second.size();
+  }
+  live += m_epoch.size();
+  if (m_journal.needsCompaction(live)) {
+    DagJournal::Snapshot snapshot;
+    for (auto& l : m_waitlist) {
+      for (auto s : l.second) {
+        snapshot.frontier.insert(m_interner->lookup(s));
+      }
+    }
+    for (auto& p : m_pending) {
+      auto& blocked = snapshot.pending[m_interner->lookup(p.first)];
+      for (auto n : p.second) {
+        blocked.push_back(m_interner->lookup(n));
+      }
+    }
+    for (auto s : m_epoch) {
+      snapshot.epoch.push_back(m_interner->lookup(s));
+    }
+    if (m_lastEpoch > 0) {
+      snapshot.lastCheckpoint = toCheckpointName(m_lastEpoch);
     }
+    m_journal.compact(snapshot);
   }
-  m_waitlist[m_policyIntf.evaluater(state)].insert(state.stateName);
 }
 } // namespace cledger::dag
\ No newline at end of file
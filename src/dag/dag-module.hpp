@@ -2,8 +2,15 @@
 #define CLEDGER_DAG_EDGE_HPP
 
 #include "record.hpp"
-#include "dag/interlock-policy.hpp"
+#include "dag/dag-journal.hpp"
+#include "dag/epoch-checkpoint.hpp"
+#include "dag/interlock-policy-dispatch.hpp"
+#include "dag/name-interner.hpp"
 #include "storage/ledger-storage.hpp"
+
+#include <deque>
+#include <memory_resource>
+
 namespace cledger::dag {
 
 class DagModule {
@@ -12,6 +19,23 @@ public:
   // TODO: need an explicit constructor
   DagModule(storage::Interface storageIntf, policy::Interface policyIntf);
 
+  /**
+   * @brief Bind the policy by its type, see policy::PolicyDispatch.
+   *
+   * @p policy must outlive the module.
+   */
+  DagModule(storage::Interface storageIntf, policy::InterlockPolicy& policy);
+
+  /**
+   * @brief Rebuild the waitlist and the missing-parent index from the stored journal.
+   *
+   * Only the states that were pending are read back and re-scored, so the cost
+   * depends on the frontier size, not on the number of records in the ledger.
+   * Must be called before adding records when the storage outlives the process.
+   */
+  void
+  restore();
+
   Name
   add(const Record& record);
 
@@ -22,25 +46,101 @@ public:
   harvestBelow(const uint32_t threshold);
 
   std::set<Name>
-  getWaitList(const uint32_t value)
+  getWaitList(const uint32_t value);
+
+  std::map<const uint32_t, std::set<Name>>
+  getWaitList();
+
+  /**
+   * @brief IDs of the state Names held in memory, also usable by the module's owner.
+   */
+  std::shared_ptr<NameInterner>
+  getInterner() const
   {
-    try {
-      return m_waitlist[value];
-    }
-    catch (const std::runtime_error& e) {
-      return std::set<Name>();
-    }
+    return m_interner;
   }
 
-  std::map<const uint32_t, std::set<Name>>
-  getWaitList()
+  /**
+   * @brief States without descendants, ie. the candidates for new pointers.
+   */
+  std::vector<EdgeState>
+  getTips();
+
+  /**
+   * @brief Score the recent window in one batch, see setBatchEvaluater().
+   *
+   * The window is the states added or given a descendant since the last pass,
+   * together with their pending descendants, which a batch evaluator needs to see.
+   * No-op unless the policy interface provides a batchEvaluater.
+   */
+  void
+  evaluateWindow();
+
+  /**
+   * @brief Re-score the window with @p evaluater each time @p window states were added.
+   *
+   * Records are then no longer evaluated one by one: a new state waits in the
+   * waitlist with a score of 0, and the batch pass (e.g., an InterlockEngine) scores
+   * every state touched since the previous pass in one go. Interlocks are therefore
+   * seen up to @p window records later than with the per-record policy.
+   */
+  void
+  setBatchEvaluater(policy::BatchEvaluater evaluater, size_t window);
+
+  /**
+   * @brief Close the current epoch.
+   *
+   * Commits the records interlocked since the last checkpoint to a Merkle root,
+   * stores the checkpoint under /32=EpochCheckpoint/<epoch> and marks the states
+   * CHECKPOINTED, keeping at most @p keepDescendants of the descendants the policy
+   * selects as proof. Traversals already stop at interlocked states, so after this
+   * nothing refers to the dropped descendants again.
+   *
+   * Only the descendant sets are trimmed: the EdgeStates themselves, their tracker
+   * pages, StatusIndex entries and interned names of a closed epoch are kept, so
+   * storage still grows with the number of records ever ingested.
+   *
+   * @return the checkpoint, nullopt if nothing was interlocked in the epoch
+   */
+  optional<EpochCheckpoint>
+  checkpoint(size_t keepDescendants);
+
+  /**
+   * @brief Number of states interlocked since the last checkpoint.
+   */
+  size_t
+  getEpochSize() const
   {
-    return m_waitlist;
+    return m_epoch.size();
+  }
+
+  /**
+   * @brief Number of missing states that loaded records are waiting on.
+   */
+  size_t
+  getPendingCount() const
+  {
+    return m_pending.size();
   }
 
 CLEDGER_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
-  std::list<Name>
-  getAncestors(EdgeState state);
+  /**
+   * @brief Non-interlocked ancestors of the state, the oldest being the first.
+   *
+   * Every state met is read once. The traversal bookkeeping lives in @p arena,
+   * which the caller releases at the end of the ingestion round.
+   *
+   * @param missing collects the states pointed to but not added yet
+   */
+  std::pmr::deque<EdgeState>
+  getAncestors(const EdgeState& state, std::pmr::set<Name>& missing,
+               std::pmr::memory_resource* arena);
+
+  EdgeState
+  construct(const Name& name);
+
+  optional<EdgeState>
+  find(const Name& name);
 
   EdgeState
   getOrConstruct(const Name& name);
@@ -48,18 +148,58 @@ CLEDGER_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   update(EdgeState state);
 
+  // the per-record path, instantiated for each policy of policy::PolicyDispatch
+  template<class Policy>
   DagModule&
-  onNewRecord(EdgeState& state);
+  onNewRecord(Policy& policy, EdgeState& state, std::pmr::memory_resource* arena);
+
+  /**
+   * @brief Add the state, and the records waiting on it, as descendants of its ancestors.
+   */
+  template<class Policy>
+  void
+  evaluateAncestors(Policy& policy, EdgeState& state, const std::vector<Name>& waiting,
+                    std::pmr::memory_resource* arena);
+
+  template<class Policy>
+  void
+  addDescendant(Policy& policy, EdgeState& state, const Name& descendant);
 
+  template<class Policy>
   void
-  evaluateAncestors(EdgeState& state);
+  evaluateWaitlist(Policy& policy, EdgeState& state);
 
+  /**
+   * @brief Flush the journal entries of the last operation, compacting if needed.
+   */
   void
-  evaluateWaitlist(EdgeState& state);
+  commitJournal();
 
-  std::map<const uint32_t, std::set<Name>> m_waitlist;
   storage::Interface m_storageIntf;
+  // the in-memory structures below hold state Names by ID
+  std::shared_ptr<NameInterner> m_interner;
+  std::map<const uint32_t, std::set<NameId>> m_waitlist;
+  // missing state -> loaded states waiting on it, in arrival order
+  std::map<NameId, std::vector<NameId>> m_pending;
+  // states interlocked since the last checkpoint, in order
+  std::vector<NameId> m_epoch;
+  uint64_t m_lastEpoch = 0;
+  // batch evaluation only, per-record hooks go through m_policy
   policy::Interface m_policyIntf;
+  static constexpr size_t DEFAULT_BATCH_WINDOW = 1024;
+  size_t m_batchWindow = DEFAULT_BATCH_WINDOW;
+  // states added or given a descendant since the last batch pass, only kept with
+  // a batchEvaluater; may repeat
+  std::vector<NameId> m_recent;
+  size_t m_addedSinceWindow = 0;
+  policy::PolicyDispatch m_policy;
+  DagJournal m_journal;
+
+  // first block of the per-round arena, reused by every round
+  static constexpr size_t ARENA_BUFFER_SIZE = 16384;
+  std::unique_ptr<std::byte[]> m_arenaBuffer;
+  // where the arena grows once the first block is used up
+  std::pmr::memory_resource* m_arenaUpstream = std::pmr::get_default_resource();
 };
 
 std::ostream&
@@ -0,0 +1,207 @@
+#include "dag/dag-worker.hpp"
+
+#include <boost/asio/post.hpp>
+
+namespace cledger::dag {
+NDN_LOG_INIT(cledger.dag);
+
+DagWorker::DagWorker(boost::asio::io_context& io, DagModule& dag, uint32_t threshold,
+                     const ResultCallback& onResult, bool threaded, size_t capacity)
+  : m_io(io)
+  , m_dag(dag)
+  , m_threshold(threshold)
+  , m_onResult(onResult)
+  , m_threaded(threaded)
+  , m_queue(capacity)
+{
+  if (m_threaded) {
+    m_thread = std::thread([this] { run(); });
+  }
+}
+
+DagWorker::~DagWorker()
+{
+  m_alive.reset();
+  stop();
+  // nor are the records held back by a full queue lost, only their results
+  if (!m_backlog.empty()) {
+    NDN_LOG_DEBUG("Ingesting " << m_backlog.size() << " held records before stopping");
+  }
+  for (auto& item : m_backlog) {
+    std::lock_guard<std::mutex> lock(m_dagMutex);
+    process(item);
+  }
+  m_backlog.clear();
+}
+
+void
+DagWorker::drain()
+{
+  stop();
+  // what the thread finished, then what it never got
+  std::deque<std::function<void()>> done;
+  {
+    std::lock_guard<std::mutex> lock(m_doneMutex);
+    done.swap(m_done);
+  }
+  for (auto& then : done) {
+    then();
+  }
+  if (!m_backlog.empty()) {
+    NDN_LOG_DEBUG("Ingesting " << m_backlog.size() << " held records before stopping");
+  }
+  while (!m_backlog.empty()) {
+    auto item = std::move(m_backlog.front());
+    m_backlog.pop_front();
+    std::function<void()> then;
+    {
+      std::lock_guard<std::mutex> lock(m_dagMutex);
+      then = process(item);
+    }
+    then();
+  }
+}
+
+void
+DagWorker::stop()
+{
+  if (m_thread.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(m_parkMutex);
+      m_stop = true;
+    }
+    m_parkCv.notify_one();
+    // the worker empties the queue before it stops
+    m_thread.join();
+  }
+  // from now on, as without a thread
+  m_threaded = false;
+}
+
+void
+DagWorker::submit(Record record)
+{
+  if (!m_threaded) {
+    m_onResult(withDag([this, &record] (auto&&) { return ingest(record); }));
+    return;
+  }
+
+  Item item{record.getName(), *record.prepareContent(), {}, {}};
+  item.content.encode();
+  enqueue(std::move(item));
+}
+
+void
+DagWorker::enqueue(Item item)
+{
+  if (!m_threaded) {
+    std::function<void()> then;
+    {
+      std::lock_guard<std::mutex> lock(m_dagMutex);
+      then = process(item);
+    }
+    then();
+    return;
+  }
+
+  // keep submission order behind anything already waiting
+  if (!m_backlog.empty() || !m_queue.push(std::move(item))) {
+    NDN_LOG_DEBUG("DAG queue is full, holding " << (item.work ? "posted work" : item.name.toUri()));
+    m_backlog.push_back(std::move(item));
+    return;
+  }
+  wakeUp();
+}
+
+DagWorker::Result
+DagWorker::ingest(const Record& record)
+{
+  Result result;
+  result.stateName = m_dag.add(record);
+  result.interlocked = m_dag.harvestAbove(m_threshold, true);
+  result.tips = m_dag.getTips();
+  return result;
+}
+
+std::function<void()>
+DagWorker::process(Item& item)
+{
+  if (item.work) {
+    item.work(m_dag);
+    return std::move(item.then);
+  }
+  auto result = ingest(Record(item.name, item.content));
+  return [this, result = std::move(result)] { m_onResult(result); };
+}
+
+void
+DagWorker::run()
+{
+  NDN_LOG_DEBUG("DAG worker started");
+  Item item;
+  while (true) {
+    if (m_queue.pop(item)) {
+      auto then = withDag([this, &item] (auto&&) { return process(item); });
+      {
+        // kept here rather than in the handler, so that drain() can deliver it
+        std::lock_guard<std::mutex> lock(m_doneMutex);
+        m_done.push_back(std::move(then));
+      }
+      boost::asio::post(m_io, [this, alive = std::weak_ptr<bool>(m_alive)] {
+        if (alive.lock()) {
+          deliver();
+          refill();
+        }
+      });
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(m_parkMutex);
+    if (m_stop) {
+      break;
+    }
+    m_parkCv.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+  }
+  NDN_LOG_DEBUG("DAG worker stopped");
+}
+
+void
+DagWorker::deliver()
+{
+  std::function<void()> then;
+  {
+    std::lock_guard<std::mutex> lock(m_doneMutex);
+    // already delivered by drain()
+    if (m_done.empty()) {
+      return;
+    }
+    then = std::move(m_done.front());
+    m_done.pop_front();
+  }
+  then();
+}
+
+void
+DagWorker::refill()
+{
+  bool moved = false;
+  while (!m_backlog.empty() && m_queue.push(std::move(m_backlog.front()))) {
+    m_backlog.pop_front();
+    moved = true;
+  }
+  if (moved) {
+    wakeUp();
+  }
+}
+
+void
+DagWorker::wakeUp()
+{
+  {
+    // pairs with the predicate check in run(), so the notification cannot be lost
+    std::lock_guard<std::mutex> lock(m_parkMutex);
+  }
+  m_parkCv.notify_one();
+}
+
+} // namespace cledger::dag
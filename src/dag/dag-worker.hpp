@@ -0,0 +1,163 @@
+#ifndef CLEDGER_DAG_DAG_WORKER_HPP
+#define CLEDGER_DAG_DAG_WORKER_HPP
+
+#include "dag/dag-module.hpp"
+#include "util/mpsc-queue.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+#include <boost/asio/io_context.hpp>
+
+namespace cledger::dag {
+
+/**
+ * @brief Runs DagModule ingestion off the io_context thread.
+ *
+ * Records are handed over through a bounded lock-free queue and ingested (add, then
+ * harvest) on a dedicated thread; each result is posted back to the io_context.
+ * Without a thread, records are ingested inline and results delivered synchronously.
+ * Other work on the DAG goes through the same queue with post(), so the io_context
+ * thread never waits for an ingestion. On destruction, everything already submitted
+ * is still ingested, but only drain() delivers the results not delivered yet.
+ */
+class DagWorker : boost::noncopyable
+{
+public:
+  struct Result
+  {
+    Name stateName;
+    // records interlocked (and removed from the waitlist) by this ingestion
+    std::list<Record> interlocked;
+    // states without descendants once the record is in
+    std::vector<EdgeState> tips;
+  };
+  using ResultCallback = std::function<void(const Result&)>;
+
+  DagWorker(boost::asio::io_context& io, DagModule& dag, uint32_t threshold,
+            const ResultCallback& onResult, bool threaded = false, size_t capacity = 1024);
+
+  ~DagWorker();
+
+  /**
+   * @brief Stop the thread once it has ingested everything submitted, and deliver the
+   *        results not delivered yet, in submission order.
+   *
+   * Must be called from the io_context thread. Records submitted afterwards are
+   * ingested inline, as without a thread.
+   */
+  void
+  drain();
+
+  /**
+   * @brief Queue a record for ingestion, must be called from the io_context thread.
+   *
+   * When the queue is full, records wait in an overflow list in submission order and
+   * are moved into the queue as the worker catches up.
+   */
+  void
+  submit(Record record);
+
+  /**
+   * @brief Run @p work on the DagModule after the records submitted so far, then pass
+   *        its result to @p then on the io_context thread.
+   *
+   * Must be called from the io_context thread. Without a thread, both run inline.
+   */
+  template<typename Work, typename Then>
+  void
+  post(Work work, Then then)
+  {
+    using Value = std::invoke_result_t<Work, DagModule&>;
+    auto value = std::make_shared<Value>();
+    enqueue(Item{{}, {}, [work = std::move(work), value] (DagModule& dag) { *value = work(dag); },
+                 [then = std::move(then), value] { then(std::move(*value)); }});
+  }
+
+  /**
+   * @brief Access the DagModule exclusively of the worker, blocking until it is free.
+   */
+  template<typename F>
+  auto
+  withDag(const F& f)
+  {
+    std::lock_guard<std::mutex> lock(m_dagMutex);
+    return f(m_dag);
+  }
+
+CLEDGER_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  // a record with its own copy of the content, safe to move across threads,
+  // or some work posted on the DAG
+  struct Item
+  {
+    Name name;
+    Block content;
+    std::function<void(DagModule&)> work;
+    std::function<void()> then;
+  };
+
+  void
+  enqueue(Item item);
+
+  Result
+  ingest(const Record& record);
+
+  /**
+   * @brief Handle one item on the worker side, under the DAG lock.
+   * @return what to call on the io_context thread afterwards
+   */
+  std::function<void()>
+  process(Item& item);
+
+  void
+  run();
+
+  /**
+   * @brief Join the thread, which empties the queue first.
+   */
+  void
+  stop();
+
+  /**
+   * @brief Call the oldest of the results the thread has finished.
+   */
+  void
+  deliver();
+
+  /**
+   * @brief Move held items into the queue as it empties.
+   */
+  void
+  refill();
+
+  void
+  wakeUp();
+
+  boost::asio::io_context& m_io;
+  DagModule& m_dag;
+  uint32_t m_threshold;
+  ResultCallback m_onResult;
+  bool m_threaded;
+
+  std::mutex m_dagMutex;
+  util::MpscQueue<Item> m_queue;
+  std::deque<Item> m_backlog;
+  // results finished by the thread, each with a deliver() posted to the io_context
+  std::mutex m_doneMutex;
+  std::deque<std::function<void()>> m_done;
+
+  std::mutex m_parkMutex;
+  std::condition_variable m_parkCv;
+  bool m_stop = false;
+  std::thread m_thread;
+
+  // guards results posted after destruction
+  std::shared_ptr<bool> m_alive = std::make_shared<bool>(true);
+};
+
+} // namespace cledger::dag
+
+#endif // CLEDGER_DAG_DAG_WORKER_HPP
@@ -70,7 +70,7 @@ decodeEdgeStateList(Block& block)
       case TLV_EDGE_STATE_LIST_VALUE:
         item.parse();
         for (const auto& stateName : item.elements()) {
-          stateList.value.insert(Name(stateName));
+          stateList.value.push_back(Name(stateName));
         }
         break;
       case TLV_EDGE_STATE_LIST_NEXT:
@@ -12,7 +12,8 @@ struct EdgeStateList
 {
   Name listName;
   uint32_t key;
-  std::set<Name> value;
+  // in the order the states were added
+  std::vector<Name> value;
 
   Name nextList;
 };
@@ -12,6 +12,8 @@ struct EdgeState
     INITIALIZED = 0,
     LOADED = 2,
     INTERLOCKED = 3,
+    // interlocked and committed to an epoch checkpoint, only the proof descendants are kept
+    CHECKPOINTED = 4,
   };
   Name stateName;
 
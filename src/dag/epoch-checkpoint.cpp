@@ -0,0 +1,115 @@
+#include "dag/epoch-checkpoint.hpp"
+#include "util/merkle.hpp"
+
+#include <ndn-cxx/util/string-helper.hpp>
+
+namespace cledger::dag {
+
+enum : uint32_t {
+  TLV_EPOCH_CHECKPOINT_TYPE = 401,
+  TLV_EPOCH_CHECKPOINT_EPOCH = 402,
+  TLV_EPOCH_CHECKPOINT_ROOT = 403,
+  TLV_EPOCH_CHECKPOINT_SIZE = 404,
+  TLV_EPOCH_CHECKPOINT_RECORDS = 405,
+};
+
+Name
+toCheckpointName(uint64_t epoch)
+{
+  return Name(checkpointNameHeader).appendNumber(epoch);
+}
+
+uint64_t
+fromCheckpointName(const Name& checkpointName)
+{
+  return checkpointName.get(-1).toNumber();
+}
+
+Buffer
+computeCheckpointRoot(const std::vector<Name>& records)
+{
+  std::vector<ndn::ConstBufferPtr> leaves;
+  leaves.reserve(records.size());
+  for (auto& r : records) {
+    leaves.push_back(util::merkle::hashLeaf(r.wireEncode()));
+  }
+  auto root = util::merkle::computeRoot(leaves);
+  return Buffer(root->begin(), root->end());
+}
+
+Block
+encodeEpochCheckpoint(const EpochCheckpoint& checkpoint)
+{
+  Block block(TLV_EPOCH_CHECKPOINT_TYPE);
+  block.push_back(checkpoint.checkpointName.wireEncode());
+  block.push_back(ndn::makeNonNegativeIntegerBlock(TLV_EPOCH_CHECKPOINT_EPOCH, checkpoint.epoch));
+  block.push_back(ndn::makeBinaryBlock(TLV_EPOCH_CHECKPOINT_ROOT, checkpoint.root));
+  block.push_back(ndn::makeNonNegativeIntegerBlock(TLV_EPOCH_CHECKPOINT_SIZE, checkpoint.size));
+
+  Buffer nameBuffer;
+  for (auto& r : checkpoint.records) {
+    auto b = r.wireEncode();
+    nameBuffer.insert(nameBuffer.end(), b.begin(), b.end());
+  }
+  if (checkpoint.records.size() > 0) {
+    block.push_back(ndn::makeBinaryBlock(TLV_EPOCH_CHECKPOINT_RECORDS,
+      span<const uint8_t>(nameBuffer.data(), nameBuffer.size())));
+  }
+  block.encode();
+  return block;
+}
+
+EpochCheckpoint
+decodeEpochCheckpoint(const Block& block)
+{
+  EpochCheckpoint checkpoint;
+  block.parse();
+  if (block.type() != TLV_EPOCH_CHECKPOINT_TYPE) {
+    NDN_THROW(std::runtime_error("TLV Type is incorrect"));
+  }
+  for (const auto &item : block.elements()) {
+    switch (item.type()) {
+      case ndn::tlv::Name:
+        checkpoint.checkpointName = Name(item);
+        break;
+      case TLV_EPOCH_CHECKPOINT_EPOCH:
+        checkpoint.epoch = ndn::readNonNegativeInteger(item);
+        break;
+      case TLV_EPOCH_CHECKPOINT_ROOT:
+        checkpoint.root = Buffer(item.value_begin(), item.value_end());
+        break;
+      case TLV_EPOCH_CHECKPOINT_SIZE:
+        checkpoint.size = ndn::readNonNegativeInteger(item);
+        break;
+      case TLV_EPOCH_CHECKPOINT_RECORDS:
+        item.parse();
+        for (const auto& r : item.elements()) {
+          checkpoint.records.push_back(Name(r));
+        }
+        break;
+      default:
+        if (ndn::tlv::isCriticalType(item.type())) {
+          NDN_THROW(std::runtime_error("Unrecognized TLV Type: " + std::to_string(item.type())));
+        }
+        else {
+          //ignore
+        }
+        break;
+    }
+  }
+  return checkpoint;
+}
+
+std::ostream&
+operator<<(std::ostream& os, const EpochCheckpoint& checkpoint)
+{
+  os << "Epoch Checkpoint Name: " << checkpoint.checkpointName << "\n";
+  os << "   Epoch: " << checkpoint.epoch << "\n";
+  os << "   Merkle Root: " << ndn::toHex(checkpoint.root) << "\n";
+  os << "   Size: " << checkpoint.size << "\n";
+  for (auto& r : checkpoint.records) {
+    os << "   Record: " << r << "\n";
+  }
+  return os;
+}
+} // cledger::dag
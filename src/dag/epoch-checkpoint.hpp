@@ -0,0 +1,49 @@
+#ifndef CLEDGER_DAG_EPOCH_CHECKPOINT_HPP
+#define CLEDGER_DAG_EPOCH_CHECKPOINT_HPP
+
+#include "cledger-common.hpp"
+namespace cledger::dag {
+
+const std::string checkpointNameHeader = "/32=EpochCheckpoint";
+
+/**
+ * @brief Commitment to the records interlocked during one epoch.
+ *
+ * The root is the Merkle Tree Hash (RFC 6962) over the record names, in the
+ * order they were interlocked. The stored object keeps the names so that the
+ * tree can be rebuilt; the published one only carries the root and the size.
+ */
+struct EpochCheckpoint
+{
+  Name checkpointName;
+  uint64_t epoch = 0;
+  Buffer root;
+  uint64_t size = 0;
+  // record names, may be left out
+  std::vector<Name> records;
+};
+
+Name
+toCheckpointName(uint64_t epoch);
+
+uint64_t
+fromCheckpointName(const Name& checkpointName);
+
+/**
+ * @brief Merkle root over the given record names.
+ */
+Buffer
+computeCheckpointRoot(const std::vector<Name>& records);
+
+Block
+encodeEpochCheckpoint(const EpochCheckpoint& checkpoint);
+
+EpochCheckpoint
+decodeEpochCheckpoint(const Block& block);
+
+std::ostream&
+operator<<(std::ostream& os, const EpochCheckpoint& checkpoint);
+
+} // namespace cledger::dag
+
+#endif // CLEDGER_DAG_EPOCH_CHECKPOINT_HPP
@@ -0,0 +1,109 @@
+#include "dag/interlock-engine.hpp"
+#include "dag/interlock-policy-descendants.hpp"
+#include "dag/interlock-policy-witness.hpp"
+#include "util/bitset.hpp"
+
+#include <algorithm>
+
+namespace cledger::dag::policy {
+
+InterlockEngine::InterlockEngine(const std::string& policyType)
+{
+  if (policyType == InterlockPolicyDescendants::POLICY_TYPE) {
+    m_mode = Mode::DESCENDANTS;
+  }
+  else if (policyType == InterlockPolicyWitness::POLICY_TYPE) {
+    m_mode = Mode::WITNESS;
+  }
+  else {
+    NDN_THROW(std::runtime_error("No batch evaluation for interlock policy " + policyType));
+  }
+}
+
+std::map<Name, uint32_t>
+InterlockEngine::evaluate(const std::vector<EdgeState>& window)
+{
+  const size_t n = window.size();
+  std::map<Name, size_t> index;
+  for (size_t i = 0; i < n; i++) {
+    index.emplace(window[i].stateName, i);
+  }
+
+  // the bit a node contributes to its ancestors: itself, or its producer
+  std::vector<size_t> bit(n);
+  size_t nBits = n;
+  if (m_mode == Mode::WITNESS) {
+    std::map<Name, size_t> producers;
+    for (size_t i = 0; i < n; i++) {
+      auto producer = producers.emplace(fromStateName(window[i].stateName).getPrefix(-1),
+                                        producers.size());
+      bit[i] = producer.first->second;
+    }
+    nBits = producers.size();
+  }
+  else {
+    for (size_t i = 0; i < n; i++) {
+      bit[i] = i;
+    }
+  }
+
+  // edges inside the window, without self pointers (genesis) and duplicates
+  std::vector<std::vector<size_t>> parents(n);
+  std::vector<size_t> pendingChildren(n, 0);
+  for (size_t i = 0; i < n; i++) {
+    for (auto& ptr : window[i].record.getPointers()) {
+      auto parent = index.find(toStateName(ptr));
+      if (parent == index.end() || parent->second == i) {
+        continue;
+      }
+      auto& p = parents[i];
+      if (std::find(p.begin(), p.end(), parent->second) != p.end()) {
+        continue;
+      }
+      p.push_back(parent->second);
+      pendingChildren[parent->second]++;
+    }
+  }
+
+  // one contiguous row of words per node
+  const size_t nWords = (nBits + util::Bitset::WORD_BITS - 1) / util::Bitset::WORD_BITS;
+  std::vector<uint64_t> rows(n * nWords, 0);
+  auto row = [&rows, nWords] (size_t i) { return rows.data() + i * nWords; };
+
+  // reverse topological order, starting from nodes without children in the window;
+  // a parent is expanded only after all its children have been ORed into it
+  std::vector<size_t> order;
+  order.reserve(n);
+  for (size_t i = 0; i < n; i++) {
+    if (pendingChildren[i] == 0) {
+      order.push_back(i);
+    }
+  }
+  for (size_t k = 0; k < order.size(); k++) {
+    auto child = order[k];
+    for (auto parent : parents[child]) {
+      util::orWords(row(parent), row(child), nWords);
+      row(parent)[bit[child] / util::Bitset::WORD_BITS] |=
+        uint64_t(1) << (bit[child] % util::Bitset::WORD_BITS);
+      if (--pendingChildren[parent] == 0) {
+        order.push_back(parent);
+      }
+    }
+  }
+
+  std::map<Name, uint32_t> ret;
+  for (size_t i = 0; i < n; i++) {
+    ret.emplace(window[i].stateName, util::countWords(row(i), nWords));
+  }
+  return ret;
+}
+
+Interface
+InterlockEngine::getInterface(const Interface& perRecord)
+{
+  Interface intf = perRecord;
+  intf.batchEvaluater = std::bind(&InterlockEngine::evaluate, this, _1);
+  return intf;
+}
+
+} // namespace cledger::dag::policy
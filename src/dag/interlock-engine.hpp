@@ -0,0 +1,49 @@
+#ifndef CLEDGER_DAG_INTERLOCK_ENGINE_HPP
+#define CLEDGER_DAG_INTERLOCK_ENGINE_HPP
+
+#include "interlock-policy.hpp"
+
+namespace cledger::dag::policy {
+
+/**
+ * @brief Batch evaluator over a window of pending EdgeStates.
+ *
+ * Instead of walking ancestors record by record, the engine keeps one reachability
+ * bitset per window node and ORs every child's set into its parents in reverse
+ * topological order. The score of a node is then a popcount of its row:
+ *   - policy-descendants: bits are window nodes, i.e., the descendants;
+ *   - policy-witness: bits are producers, i.e., the distinct witnesses.
+ *
+ * Pointers to states outside the window are ignored, so the window must contain
+ * every pending state together with their descendants (e.g., DagModule's waitlist).
+ */
+class InterlockEngine
+{
+public:
+  /**
+   * @throw std::runtime_error if @p policyType has no batch equivalent
+   */
+  explicit
+  InterlockEngine(const std::string& policyType);
+
+  std::map<Name, uint32_t>
+  evaluate(const std::vector<EdgeState>& window);
+
+  /**
+   * @brief Extend a per-record policy interface with this batch evaluator.
+   */
+  Interface
+  getInterface(const Interface& perRecord);
+
+private:
+  enum class Mode {
+    DESCENDANTS,
+    WITNESS,
+  };
+
+  Mode m_mode;
+};
+
+} // namespace cledger::dag::policy
+
+#endif // CLEDGER_DAG_INTERLOCK_ENGINE_HPP
@@ -11,23 +11,12 @@ InterlockPolicyDescendants::InterlockPolicyDescendants(const std::string& intern
 }
 
 
-std::set<Name>
-InterlockPolicyDescendants::select(const EdgeState& state)
-{
-  return state.descendants;
-}
-
-uint32_t
-InterlockPolicyDescendants::evaluate(const EdgeState& state)
-{
-  return select(state).size();
-}
-
 Interface
 InterlockPolicyDescendants::getInterface()
 {
   Interface intf;
   intf.evaluater = std::bind(&InterlockPolicyDescendants::evaluate, this, _1);
+  intf.selector = std::bind(&InterlockPolicyDescendants::select, this, _1);
   return intf;  
 }
 } // namespace cledger::dag::policy
\ No newline at end of file
@@ -4,20 +4,37 @@
 #include "interlock-policy.hpp"
 namespace cledger::dag::policy {
 
-class InterlockPolicyDescendants : public InterlockPolicy
+class InterlockPolicyDescendants final : public InterlockPolicy
 {
 public:
   InterlockPolicyDescendants(const std::string& internalConfig = "");
   const static std::string POLICY_TYPE;
 
   std::set<Name>
-  select(const EdgeState& state) override;
+  select(const EdgeState& state) override
+  {
+    return state.descendants;
+  }
 
   uint32_t
-  evaluate(const EdgeState& state) override;
+  evaluate(const EdgeState& state) override
+  {
+    return state.descendants.size();
+  }
 
   Interface
   getInterface() override;
+
+  // no per-state cache, see PolicyDispatch
+  void
+  track(const EdgeState&, const Name&)
+  {
+  }
+
+  void
+  release(const Name&)
+  {
+  }
 };
 
 } // namespace cledger::dag::policy
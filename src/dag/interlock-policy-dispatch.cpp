@@ -0,0 +1,17 @@
+#include "dag/interlock-policy-dispatch.hpp"
+
+namespace cledger::dag::policy {
+
+PolicyDispatch
+makePolicyDispatch(InterlockPolicy& policy)
+{
+  if (auto descendants = dynamic_cast<InterlockPolicyDescendants*>(&policy)) {
+    return descendants;
+  }
+  if (auto witness = dynamic_cast<InterlockPolicyWitness*>(&policy)) {
+    return witness;
+  }
+  return DynamicPolicy(policy.getInterface());
+}
+
+} // namespace cledger::dag::policy
@@ -0,0 +1,98 @@
+#ifndef CLEDGER_DAG_INTERLOCK_POLICY_DISPATCH_HPP
+#define CLEDGER_DAG_INTERLOCK_POLICY_DISPATCH_HPP
+
+#include "dag/interlock-policy-descendants.hpp"
+#include "dag/interlock-policy-witness.hpp"
+
+#include <variant>
+
+namespace cledger::dag::policy {
+
+/**
+ * @brief Per-record hooks of an arbitrary policy, called through its Interface.
+ *
+ * Has the same members as the built-in policies, so that DagModule's per-record code
+ * is written once and instantiated for each of them.
+ */
+class DynamicPolicy
+{
+public:
+  explicit
+  DynamicPolicy(Interface intf)
+    : m_intf(std::move(intf))
+  {
+  }
+
+  std::set<Name>
+  select(const EdgeState& state)
+  {
+    return m_intf.selector ? m_intf.selector(state) : state.descendants;
+  }
+
+  uint32_t
+  evaluate(const EdgeState& state)
+  {
+    return m_intf.evaluater(state);
+  }
+
+  void
+  track(const EdgeState& state, const Name& descendant)
+  {
+    if (m_intf.tracker) {
+      m_intf.tracker(state, descendant);
+    }
+  }
+
+  void
+  release(const Name& stateName)
+  {
+    if (m_intf.releaser) {
+      m_intf.releaser(stateName);
+    }
+  }
+
+private:
+  Interface m_intf;
+};
+
+/**
+ * @brief The policy as seen by DagModule.
+ *
+ * The built-in policies are held by their final type, so their hooks are called
+ * directly (and inlined where defined in the header) in the ancestor loop, instead of
+ * going through std::function, std::bind and a virtual call for every ancestor.
+ * Any other policy goes through its Interface.
+ */
+using PolicyDispatch = std::variant<DynamicPolicy, InterlockPolicyDescendants*, InterlockPolicyWitness*>;
+
+/**
+ * @brief Pick the specialization matching the dynamic type of @p policy.
+ *
+ * @p policy must outlive the returned dispatch.
+ */
+PolicyDispatch
+makePolicyDispatch(InterlockPolicy& policy);
+
+/**
+ * @brief Call @p visitor with the policy held by @p dispatch.
+ *
+ * Resolve the policy once and run the whole loop inside the visitor to keep the
+ * variant out of the hot path.
+ */
+template<class Visitor>
+decltype(auto)
+visitPolicy(PolicyDispatch& dispatch, Visitor&& visitor)
+{
+  return std::visit([&visitor] (auto& policy) -> decltype(auto) {
+    if constexpr (std::is_pointer_v<std::decay_t<decltype(policy)>>) {
+      return visitor(*policy);
+    }
+    else {
+      return visitor(policy);
+    }
+  }, dispatch);
+}
+
+} // namespace cledger::dag::policy
+
+#endif // CLEDGER_DAG_INTERLOCK_POLICY_DISPATCH_HPP
@@ -30,7 +30,52 @@ InterlockPolicyWitness::select(const EdgeState& state)
 uint32_t
 InterlockPolicyWitness::evaluate(const EdgeState& state)
 {
-  return select(state).size();
+  auto& entry = m_entries[m_interner->intern(state.stateName)];
+  if (entry.folded != state.descendants.size()) {
+    // cold cache (e.g., first evaluation after loading from storage) or
+    // descendants inserted without notification, rebuild it once
+    entry = WitnessEntry();
+    for (auto& item : state.descendants) {
+      fold(entry, item);
+    }
+  }
+  return entry.producers.count();
+}
+
+void
+InterlockPolicyWitness::track(const EdgeState& state, const Name& descendant)
+{
+  auto entry = m_entries.find(m_interner->intern(state.stateName));
+  if (entry == m_entries.end()) {
+    // built on the next evaluation
+    return;
+  }
+  if (entry->second.folded + 1 == state.descendants.size()) {
+    fold(entry->second, descendant);
+  }
+}
+
+void
+InterlockPolicyWitness::release(const Name& stateName)
+{
+  if (auto id = m_interner->find(stateName)) {
+    m_entries.erase(*id);
+  }
+}
+
+uint32_t
+InterlockPolicyWitness::getProducerId(const Name& descendant)
+{
+  auto dataPrefix = dag::fromStateName(descendant).getPrefix(-1);
+  auto id = m_producerIds.emplace(dataPrefix, m_producerIds.size());
+  return id.first->second;
+}
+
+void
+InterlockPolicyWitness::fold(WitnessEntry& entry, const Name& descendant)
+{
+  entry.producers.set(getProducerId(descendant));
+  entry.folded++;
 }
 
 Interface
@@ -38,6 +83,9 @@ InterlockPolicyWitness::getInterface()
 {
   Interface intf;
   intf.evaluater = std::bind(&InterlockPolicyWitness::evaluate, this, _1);
+  intf.selector = std::bind(&InterlockPolicyWitness::select, this, _1);
+  intf.tracker = std::bind(&InterlockPolicyWitness::track, this, _1, _2);
+  intf.releaser = std::bind(&InterlockPolicyWitness::release, this, _1);
   return intf;  
 }
-} // namespace cledger::dag::policy
\ No newline at end of file
+} // namespace cledger::dag::policy
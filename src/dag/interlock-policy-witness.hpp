@@ -2,9 +2,14 @@
 #define CLEDGER_DAG_INTERLOCK_POLICY_WITNESS_HPP
 
 #include "interlock-policy.hpp"
+#include "dag/name-interner.hpp"
+#include "util/bitset.hpp"
+
+#include <unordered_map>
+
 namespace cledger::dag::policy {
 
-class InterlockPolicyWitness : public InterlockPolicy
+class InterlockPolicyWitness final : public InterlockPolicy
 {
 public:
   InterlockPolicyWitness(const std::string& internalConfig = "");
@@ -18,8 +23,45 @@ public:
 
   Interface
   getInterface() override;
+
+  void
+  track(const EdgeState& state, const Name& descendant);
+
+  void
+  release(const Name& stateName);
+
+  /**
+   * @brief Key the per-state caches by the IDs of @p interner, e.g., the DAG's.
+   *
+   * Otherwise the policy hands out IDs of its own. Call before the first evaluation.
+   */
+  void
+  setInterner(std::shared_ptr<NameInterner> interner)
+  {
+    m_interner = std::move(interner);
+  }
+
+CLEDGER_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  // distinct producers seen among the descendants of one EdgeState
+  struct WitnessEntry
+  {
+    util::Bitset producers;
+    // number of descendants already folded into producers
+    size_t folded = 0;
+  };
+
+  uint32_t
+  getProducerId(const Name& descendant);
+
+  void
+  fold(WitnessEntry& entry, const Name& descendant);
+
+  // producer (data prefix) -> dense ID
+  std::map<Name, uint32_t> m_producerIds;
+  std::shared_ptr<NameInterner> m_interner = std::make_shared<NameInterner>();
+  std::unordered_map<NameId, WitnessEntry> m_entries;
 };
 
 } // namespace cledger::dag::policy
 
-#endif // CLEDGER_DAG_INTERLOCK_POLICY_WITNESS_HPP
\ No newline at end of file
+#endif // CLEDGER_DAG_INTERLOCK_POLICY_WITNESS_HPP
@@ -6,8 +6,22 @@
 namespace cledger::dag::policy {
 
 using Evaluater = std::function<uint32_t(const EdgeState&)>;
+// the descendants that prove the state is interlocked
+using Selector = std::function<std::set<Name>(const EdgeState&)>;
+// notified after a new descendant has been inserted into the state
+using Tracker = std::function<void(const EdgeState&, const Name&)>;
+// notified once the state is interlocked and will not be evaluated again
+using Releaser = std::function<void(const Name&)>;
+// scores a window of pending states at once, keyed by state name
+using BatchEvaluater = std::function<std::map<Name, uint32_t>(const std::vector<EdgeState>&)>;
 struct Interface {
   Evaluater evaluater;
+  Selector selector;
+  // optional, for policies that keep incremental per-state caches
+  Tracker tracker;
+  Releaser releaser;
+  // optional, see InterlockEngine
+  BatchEvaluater batchEvaluater;
 };
 
 class InterlockPolicy
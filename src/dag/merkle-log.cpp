@@ -0,0 +1,184 @@
+#include "dag/merkle-log.hpp"
+#include "util/merkle.hpp"
+
+namespace cledger::dag {
+NDN_LOG_INIT(cledger.dag.merkle);
+
+enum : uint32_t {
+  TLV_MERKLE_LOG_NODE = 411,
+  TLV_MERKLE_LOG_LEAF_INDEX = 412,
+};
+
+static Name
+toNodeName(uint32_t level, uint64_t index)
+{
+  return Name(merkleLogNameHeader).appendNumber(level).appendNumber(index);
+}
+
+static Name
+toLeafName(const Buffer& leafHash)
+{
+  return Name(merkleLogNameHeader).append("leaf").append(make_span(leafHash));
+}
+
+// largest power of two strictly smaller than n, for n > 1
+static uint64_t
+splitPoint(uint64_t n)
+{
+  uint64_t k = 1;
+  while (k * 2 < n) {
+    k *= 2;
+  }
+  return k;
+}
+
+MerkleLog::MerkleLog(storage::Interface storageIntf)
+  : m_storageIntf(storageIntf)
+{
+  // leaves are contiguous from 0, find the first missing one
+  if (hasLeaf(0)) {
+    uint64_t lo = 0;
+    uint64_t hi = 1;
+    while (hasLeaf(hi)) {
+      lo = hi;
+      hi *= 2;
+    }
+    while (hi - lo > 1) {
+      uint64_t mid = lo + (hi - lo) / 2;
+      if (hasLeaf(mid)) {
+        lo = mid;
+      }
+      else {
+        hi = mid;
+      }
+    }
+    m_size = hi;
+  }
+  NDN_LOG_DEBUG("Merkle log has " << m_size << " leaves");
+}
+
+uint64_t
+MerkleLog::append(span<const uint8_t> leafData)
+{
+  auto found = find(leafData);
+  if (found) {
+    return *found;
+  }
+
+  auto leafHash = util::merkle::hashLeaf(leafData);
+  uint64_t leafIndex = m_size;
+  put(toLeafName(*leafHash), ndn::makeNonNegativeIntegerBlock(TLV_MERKLE_LOG_LEAF_INDEX, leafIndex));
+
+  // the subtrees this leaf completes
+  Buffer hash(*leafHash);
+  uint64_t index = leafIndex;
+  uint32_t level = 0;
+  while (index & 1) {
+    hash = *util::merkle::hashChildren(getNode(level, index - 1), hash);
+    index >>= 1;
+    level++;
+    putNode(level, index, hash);
+  }
+  // the leaf itself goes last, it marks the append as complete
+  putNode(0, leafIndex, *leafHash);
+  m_size++;
+  m_root = nullopt;
+  return leafIndex;
+}
+
+optional<uint64_t>
+MerkleLog::find(span<const uint8_t> leafData)
+{
+  auto leafHash = util::merkle::hashLeaf(leafData);
+  try {
+    auto index = ndn::readNonNegativeInteger(m_storageIntf.getter(toLeafName(*leafHash)));
+    if (index < m_size) {
+      return index;
+    }
+  }
+  catch (const std::exception&) {
+  }
+  return nullopt;
+}
+
+Buffer
+MerkleLog::root()
+{
+  if (!m_root) {
+    m_root = m_size == 0 ? Buffer(*Sha256().computeDigest()) : subtreeHash(0, m_size);
+  }
+  return *m_root;
+}
+
+std::vector<Buffer>
+MerkleLog::prove(uint64_t leafIndex)
+{
+  if (leafIndex >= m_size) {
+    NDN_THROW(std::runtime_error("Leaf " + std::to_string(leafIndex) + " is not in the log"));
+  }
+  // siblings from the root down, returned from the leaf up
+  std::vector<Buffer> path;
+  uint64_t begin = 0;
+  uint64_t end = m_size;
+  while (end - begin > 1) {
+    uint64_t k = splitPoint(end - begin);
+    if (leafIndex < begin + k) {
+      path.push_back(subtreeHash(begin + k, end));
+      end = begin + k;
+    }
+    else {
+      path.push_back(subtreeHash(begin, begin + k));
+      begin = begin + k;
+    }
+  }
+  return {path.rbegin(), path.rend()};
+}
+
+Buffer
+MerkleLog::getNode(uint32_t level, uint64_t index)
+{
+  auto block = m_storageIntf.getter(toNodeName(level, index));
+  return Buffer(block.value_begin(), block.value_end());
+}
+
+void
+MerkleLog::putNode(uint32_t level, uint64_t index, const Buffer& hash)
+{
+  put(toNodeName(level, index), ndn::makeBinaryBlock(TLV_MERKLE_LOG_NODE, hash));
+}
+
+void
+MerkleLog::put(const Name& name, const Block& block)
+{
+  // may overwrite what an interrupted append left over
+  m_storageIntf.replacer(name, block);
+}
+
+bool
+MerkleLog::hasLeaf(uint64_t index)
+{
+  try {
+    m_storageIntf.getter(toNodeName(0, index));
+    return true;
+  }
+  catch (const std::exception&) {
+    return false;
+  }
+}
+
+Buffer
+MerkleLog::subtreeHash(uint64_t begin, uint64_t end)
+{
+  uint64_t n = end - begin;
+  if ((n & (n - 1)) == 0 && begin % n == 0) {
+    uint32_t level = 0;
+    while ((uint64_t(1) << level) < n) {
+      level++;
+    }
+    return getNode(level, begin >> level);
+  }
+  uint64_t k = splitPoint(n);
+  return *util::merkle::hashChildren(subtreeHash(begin, begin + k), subtreeHash(begin + k, end));
+}
+
+} // namespace cledger::dag
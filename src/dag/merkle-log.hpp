@@ -0,0 +1,78 @@
+#ifndef CLEDGER_DAG_MERKLE_LOG_HPP
+#define CLEDGER_DAG_MERKLE_LOG_HPP
+
+#include "cledger-common.hpp"
+#include "storage/ledger-storage.hpp"
+namespace cledger::dag {
+
+const std::string merkleLogNameHeader = "/32=MerkleLog";
+
+/**
+ * @brief Append-only Merkle tree (RFC 6962) over interlocked records, kept in the ledger storage.
+ *
+ * The hash of every complete subtree is stored once, under /32=MerkleLog/<level>/<index>,
+ * as soon as its last leaf is appended. The hash of any range the tree splits into is
+ * then built from O(log n) stored nodes, which keeps appends, roots and audit paths
+ * logarithmic without holding the tree in memory. Leaves are found back by their hash.
+ */
+class MerkleLog
+{
+public:
+  explicit
+  MerkleLog(storage::Interface storageIntf);
+
+  /**
+   * @brief Append a leaf unless it is already in the log.
+   * @return the leaf index
+   */
+  uint64_t
+  append(span<const uint8_t> leafData);
+
+  optional<uint64_t>
+  find(span<const uint8_t> leafData);
+
+  uint64_t
+  size() const
+  {
+    return m_size;
+  }
+
+  /**
+   * @brief Root of the current tree.
+   */
+  Buffer
+  root();
+
+  /**
+   * @brief Audit path of @p leafIndex in the current tree.
+   */
+  std::vector<Buffer>
+  prove(uint64_t leafIndex);
+
+CLEDGER_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  Buffer
+  getNode(uint32_t level, uint64_t index);
+
+  void
+  putNode(uint32_t level, uint64_t index, const Buffer& hash);
+
+  void
+  put(const Name& name, const Block& block);
+
+  bool
+  hasLeaf(uint64_t index);
+
+  /**
+   * @brief Merkle Tree Hash of leaves [begin, end), begin being aligned as in the tree.
+   */
+  Buffer
+  subtreeHash(uint64_t begin, uint64_t end);
+
+  storage::Interface m_storageIntf;
+  uint64_t m_size = 0;
+  optional<Buffer> m_root;
+};
+
+} // namespace cledger::dag
+
+#endif // CLEDGER_DAG_MERKLE_LOG_HPP
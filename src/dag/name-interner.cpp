@@ -0,0 +1,235 @@
+#include "dag/name-interner.hpp"
+
+#include <limits>
+
+namespace cledger::dag {
+NDN_LOG_INIT(cledger.dag.interner);
+
+enum : uint32_t {
+  TLV_NAME_TABLE_SEGMENT = 421,
+  TLV_NAME_TABLE_FIRST_ID = 422,
+  TLV_NAME_TABLE_PAGE = 423,
+  TLV_NAME_TABLE_SIZE = 424,
+  TLV_NAME_ID = 425,
+};
+
+static Name
+toSegmentName(uint64_t segment)
+{
+  return Name(nameTableNameHeader).appendNumber(segment);
+}
+
+static Name
+toPageName(size_t page)
+{
+  return Name(nameTableNameHeader).append("page").appendNumber(page);
+}
+
+static Name
+toSizeName()
+{
+  return Name(nameTableNameHeader).append("size");
+}
+
+static Name
+toIdName(const Name& name)
+{
+  return Name(nameIdNameHeader).append(name);
+}
+
+NameInterner::NameInterner(storage::Interface storageIntf)
+  : m_storageIntf(storageIntf)
+{
+  Block size;
+  try {
+    size = m_storageIntf.getter(toSizeName());
+  }
+  catch (const std::exception& e) {
+    migrateSegments();
+    return;
+  }
+  m_size = ndn::readNonNegativeInteger(size);
+  m_flushed = m_size;
+  // new Names go on the last page
+  if (m_size % PAGE_SIZE != 0) {
+    loadPage(m_size / PAGE_SIZE);
+  }
+  NDN_LOG_DEBUG("Name table of " << m_size << " names");
+}
+
+void
+NameInterner::migrateSegments()
+{
+  // segments are contiguous, the first one missing ends the table
+  uint64_t nSegments = 0;
+  for (; ; nSegments++) {
+    Block segment;
+    try {
+      segment = m_storageIntf.getter(toSegmentName(nSegments));
+    }
+    catch (const std::exception& e) {
+      break;
+    }
+    segment.parse();
+    if (segment.type() != TLV_NAME_TABLE_SEGMENT ||
+        ndn::readNonNegativeInteger(segment.get(TLV_NAME_TABLE_FIRST_ID)) != m_size) {
+      NDN_THROW(std::runtime_error("Name table segment " + std::to_string(nSegments) + " is corrupted"));
+    }
+    for (const auto& item : segment.elements()) {
+      if (item.type() == ndn::tlv::Name) {
+        m_ids.emplace(Name(item), m_size);
+        m_pages[m_size / PAGE_SIZE].emplace_back(item);
+        m_size++;
+      }
+    }
+  }
+  if (nSegments == 0) {
+    return;
+  }
+  flush();
+  for (uint64_t i = 0; i < nSegments; i++) {
+    m_storageIntf.deleter(toSegmentName(i));
+  }
+  NDN_LOG_INFO("Migrated a name table of " << m_size << " names from " << nSegments << " segments");
+}
+
+std::deque<Name>&
+NameInterner::loadPage(size_t page) const
+{
+  auto it = m_pages.find(page);
+  if (it != m_pages.end()) {
+    return it->second;
+  }
+  Block block;
+  try {
+    block = m_storageIntf.getter(toPageName(page));
+  }
+  catch (const std::exception& e) {
+    NDN_THROW(std::runtime_error("Name table page " + std::to_string(page) + " is missing"));
+  }
+  block.parse();
+  if (block.type() != TLV_NAME_TABLE_PAGE) {
+    NDN_THROW(std::runtime_error("Name table page " + std::to_string(page) + " is corrupted"));
+  }
+  auto& names = m_pages[page];
+  // a flush cut short may have left Names past the stored size
+  for (const auto& item : block.elements()) {
+    NameId id = page * PAGE_SIZE + names.size();
+    if (id >= m_flushed) {
+      break;
+    }
+    names.emplace_back(item);
+    m_ids.emplace(names.back(), id);
+  }
+  return names;
+}
+
+NameId
+NameInterner::intern(const Name& name)
+{
+  if (auto id = find(name)) {
+    return *id;
+  }
+  std::unique_lock<std::shared_mutex> lock(m_mutex);
+  // may have been interned since the shared lock was released
+  auto it = m_ids.find(name);
+  if (it != m_ids.end()) {
+    return it->second;
+  }
+  if (m_size == std::numeric_limits<NameId>::max()) {
+    NDN_THROW(std::runtime_error("Name table is full"));
+  }
+  NameId id = m_size;
+  m_pages[id / PAGE_SIZE].push_back(name);
+  m_ids.emplace(name, id);
+  m_size++;
+  return id;
+}
+
+optional<NameId>
+NameInterner::find(const Name& name) const
+{
+  {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    auto it = m_ids.find(name);
+    if (it != m_ids.end()) {
+      return it->second;
+    }
+    if (m_flushed == 0) {
+      return nullopt;
+    }
+  }
+  std::unique_lock<std::shared_mutex> lock(m_mutex);
+  auto it = m_ids.find(name);
+  if (it != m_ids.end()) {
+    return it->second;
+  }
+  NameId id;
+  try {
+    id = ndn::readNonNegativeInteger(m_storageIntf.getter(toIdName(name)));
+  }
+  catch (const std::exception& e) {
+    return nullopt;
+  }
+  // an ID a flush cut short may have stored, since handed out again
+  if (id >= m_flushed) {
+    return nullopt;
+  }
+  const auto& page = loadPage(id / PAGE_SIZE);
+  if (page.at(id % PAGE_SIZE) != name) {
+    return nullopt;
+  }
+  m_ids.emplace(name, id);
+  return id;
+}
+
+const Name&
+NameInterner::lookup(NameId id) const
+{
+  {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    if (id >= m_size) {
+      NDN_THROW(std::out_of_range("Name ID " + std::to_string(id) + " was not handed out"));
+    }
+    auto it = m_pages.find(id / PAGE_SIZE);
+    if (it != m_pages.end()) {
+      return it->second.at(id % PAGE_SIZE);
+    }
+  }
+  std::unique_lock<std::shared_mutex> lock(m_mutex);
+  return loadPage(id / PAGE_SIZE).at(id % PAGE_SIZE);
+}
+
+size_t
+NameInterner::size() const
+{
+  std::shared_lock<std::shared_mutex> lock(m_mutex);
+  return m_size;
+}
+
+void
+NameInterner::flush()
+{
+  std::unique_lock<std::shared_mutex> lock(m_mutex);
+  if (m_flushed == m_size || !m_storageIntf.replacer) {
+    return;
+  }
+  // the last page again if it had room left, then the new ones
+  for (size_t page = m_flushed / PAGE_SIZE; page <= (m_size - 1) / PAGE_SIZE; page++) {
+    Block block(TLV_NAME_TABLE_PAGE);
+    for (const auto& name : m_pages.at(page)) {
+      block.push_back(name.wireEncode());
+    }
+    block.encode();
+    m_storageIntf.replacer(toPageName(page), block);
+  }
+  for (size_t id = m_flushed; id < m_size; id++) {
+    const auto& name = m_pages.at(id / PAGE_SIZE)[id % PAGE_SIZE];
+    m_storageIntf.replacer(toIdName(name), ndn::makeNonNegativeIntegerBlock(TLV_NAME_ID, id));
+  }
+  // what the pages hold past the size is ignored on restart
+  m_storageIntf.replacer(toSizeName(), ndn::makeNonNegativeIntegerBlock(TLV_NAME_TABLE_SIZE, m_size));
+  m_flushed = m_size;
+}
+
+} // namespace cledger::dag
@@ -0,0 +1,102 @@
+#ifndef CLEDGER_DAG_NAME_INTERNER_HPP
+#define CLEDGER_DAG_NAME_INTERNER_HPP
+
+#include "cledger-common.hpp"
+#include "storage/ledger-storage.hpp"
+
+#include <deque>
+#include <map>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace cledger::dag {
+
+const std::string nameTableNameHeader = "/32=NameTable";
+const std::string nameIdNameHeader = "/32=NameId";
+
+using NameId = uint32_t;
+
+/**
+ * @brief Dense 32-bit IDs for state Names, shared by the DAG and the ledger module.
+ *
+ * IDs are handed out in order and never reused, so in-memory sets and maps can be
+ * keyed by 4-byte integers instead of Names whose comparison walks TLV components.
+ * A flush stores the new Names in pages of PAGE_SIZE IDs, /32=NameTable/page/<n>,
+ * each Name's ID under /32=NameId/<Name>, and the table size last, so that a restart
+ * gives every Name its previous ID back.
+ *
+ * Only the size and the last page are read at startup. Other pages are read the
+ * first time one of their IDs is looked up, and stored Names the first time they are
+ * found, so startup does not grow with the table.
+ *
+ * Safe to share across threads: lookups take a shared lock, new Names and reads from
+ * storage an exclusive one.
+ */
+class NameInterner : boost::noncopyable
+{
+public:
+  static constexpr size_t PAGE_SIZE = 64;
+
+  /**
+   * @brief IDs kept in memory only, flush() stores nothing.
+   */
+  NameInterner() = default;
+
+  explicit
+  NameInterner(storage::Interface storageIntf);
+
+  /**
+   * @brief ID of @p name, assigning the next one if it is new.
+   * @throw std::runtime_error the table is full
+   */
+  NameId
+  intern(const Name& name);
+
+  optional<NameId>
+  find(const Name& name) const;
+
+  /**
+   * @throw std::out_of_range if @p id was not handed out
+   */
+  const Name&
+  lookup(NameId id) const;
+
+  size_t
+  size() const;
+
+  /**
+   * @brief Store the Names interned since the last flush.
+   */
+  void
+  flush();
+
+private:
+  /**
+   * @brief The Names of page @p page, read from storage the first time.
+   * @pre the exclusive lock is held
+   */
+  std::deque<Name>&
+  loadPage(size_t page) const;
+
+  /**
+   * @brief Read a table written by earlier versions, as numbered segments of every
+   *        Name flushed at once, and store it as pages.
+   */
+  void
+  migrateSegments();
+
+private:
+  storage::Interface m_storageIntf;
+  mutable std::shared_mutex m_mutex;
+  // the Names met so far, not every Name stored
+  mutable std::unordered_map<Name, NameId> m_ids;
+  // pages read or written so far; deques only grow at the back and map nodes do not
+  // move, so references returned by lookup() stay valid
+  mutable std::map<size_t, std::deque<Name>> m_pages;
+  size_t m_size = 0;
+  size_t m_flushed = 0;
+};
+
+} // namespace cledger::dag
+
+#endif // CLEDGER_DAG_NAME_INTERNER_HPP
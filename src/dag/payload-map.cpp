@@ -18,6 +18,13 @@ toMapName(const span<const uint8_t>& payload)
   );
 }
 
+Name
+toMapName(const Name::Component& implicitDigest)
+{
+  // both are the SHA-256 of the whole Data TLV
+  return Name(mapNameHeader).appendParametersSha256Digest(implicitDigest.value_bytes());
+}
+
 Block
 encodePayloadMap(PayloadMap& map)
 {
@@ -14,6 +14,13 @@ struct PayloadMap
 Name
 toMapName(const span<const uint8_t>& payload);
 
+/**
+ * @brief Same as toMapName(payload) when @p implicitDigest is the one of the payload Data,
+ *        without hashing it again.
+ */
+Name
+toMapName(const Name::Component& implicitDigest);
+
 Block
 encodePayloadMap(PayloadMap& map);
 
@@ -0,0 +1,182 @@
+#include "dag/state-tracker.hpp"
+
+namespace cledger::dag {
+NDN_LOG_INIT(cledger.dag.tracker);
+
+enum : uint32_t {
+  TLV_TRACKER_JOURNAL_SEGMENT = 431,
+};
+
+static Name
+toJournalName(uint64_t segment)
+{
+  return Name(trackerJournalNameHeader).appendNumber(segment);
+}
+
+// add, or replace what an earlier flush left there
+static void
+put(storage::Interface& storageIntf, const Name& name, const Block& block)
+{
+  storageIntf.replacer(name, block);
+}
+
+StateTracker::StateTracker(storage::Interface storageIntf, std::shared_ptr<NameInterner> interner,
+                           size_t pageSize)
+  : m_storageIntf(storageIntf)
+  , m_interner(std::move(interner))
+  , m_pageSize(pageSize)
+{
+  // walk the chain to the tail
+  Name pageName = toPageName(0);
+  while (pageName != getStateListNull()) {
+    Block block;
+    try {
+      block = m_storageIntf.getter(pageName);
+    }
+    catch (const std::exception& e) {
+      // no tracker yet, or a page whose successor was never flushed
+      break;
+    }
+    auto page = decodeEdgeStateList(block);
+    auto& ids = m_pages.emplace_back();
+    for (auto& s : page.value) {
+      auto id = m_interner->intern(s);
+      m_tracked.insert(id);
+      ids.push_back(id);
+    }
+    pageName = page.nextList;
+  }
+  if (m_pages.empty()) {
+    m_pages.emplace_back();
+    m_dirty.insert(0);
+  }
+  loadJournal();
+  NDN_LOG_DEBUG("Tracking " << m_tracked.size() << " EdgeStates in " << getPageCount() << " pages");
+}
+
+void
+StateTracker::loadJournal()
+{
+  // segments are contiguous from 0, the first one missing ends the journal
+  for (m_journalNext = 0; ; m_journalNext++) {
+    Block segment;
+    try {
+      segment = m_storageIntf.getter(toJournalName(m_journalNext));
+    }
+    catch (const std::exception& e) {
+      break;
+    }
+    segment.parse();
+    if (segment.type() != TLV_TRACKER_JOURNAL_SEGMENT) {
+      NDN_THROW(std::runtime_error("TLV Type is incorrect"));
+    }
+    for (const auto& item : segment.elements()) {
+      add(Name(item));
+    }
+  }
+  // already in the journal
+  m_uncommitted.clear();
+}
+
+bool
+StateTracker::add(const Name& stateName)
+{
+  auto id = m_interner->intern(stateName);
+  if (!m_tracked.insert(id).second) {
+    return false;
+  }
+  if (m_pages.back().size() >= m_pageSize) {
+    // the full page now links to the new one
+    m_dirty.insert(m_pages.size() - 1);
+    m_pages.emplace_back();
+  }
+  m_pages.back().push_back(id);
+  m_dirty.insert(m_pages.size() - 1);
+  m_uncommitted.push_back(id);
+  return true;
+}
+
+bool
+StateTracker::contains(const Name& stateName) const
+{
+  auto id = m_interner->find(stateName);
+  return id && m_tracked.count(*id) > 0;
+}
+
+Block
+StateTracker::getPage(const Name& pageName) const
+{
+  optional<uint64_t> index;
+  if (pageName == toPageName(0)) {
+    index = 0;
+  }
+  else if (pageName.size() == 3 && pageName.get(-1).isNumber() &&
+           pageName.getPrefix(-1) == Name(stateListNameHeader).append("page")) {
+    index = pageName.get(-1).toNumber();
+  }
+  if (!index || *index >= m_pages.size()) {
+    NDN_THROW(std::runtime_error(pageName.toUri() + " is not a tracker page"));
+  }
+  auto page = makePage(*index);
+  return encodeEdgeStateList(page);
+}
+
+void
+StateTracker::commit()
+{
+  if (m_uncommitted.empty()) {
+    return;
+  }
+  Block segment(TLV_TRACKER_JOURNAL_SEGMENT);
+  for (auto id : m_uncommitted) {
+    segment.push_back(m_interner->lookup(id).wireEncode());
+  }
+  segment.encode();
+  m_storageIntf.adder(toJournalName(m_journalNext), segment);
+  m_journalNext++;
+  m_uncommitted.clear();
+}
+
+void
+StateTracker::flush()
+{
+  if (m_dirty.empty()) {
+    return;
+  }
+  // successors first, so that a stored page never links to a missing one
+  for (auto it = m_dirty.rbegin(); it != m_dirty.rend(); ++it) {
+    auto page = makePage(*it);
+    put(m_storageIntf, page.listName, encodeEdgeStateList(page));
+  }
+  NDN_LOG_DEBUG("Flushed " << m_dirty.size() << " tracker pages");
+  m_dirty.clear();
+
+  // newest first, an interrupted drop leaves a journal that still starts at 0
+  while (m_journalNext > 0) {
+    m_storageIntf.deleter(toJournalName(--m_journalNext));
+  }
+  m_uncommitted.clear();
+}
+
+Name
+StateTracker::toPageName(uint64_t page)
+{
+  // not under page 0, whose prefix interests must not match the later pages
+  return page == 0 ? toStateListName(globalTracker) :
+                     Name(stateListNameHeader).append("page").appendNumber(page);
+}
+
+EdgeStateList
+StateTracker::makePage(uint64_t page) const
+{
+  EdgeStateList list;
+  list.key = globalTracker;
+  list.listName = toPageName(page);
+  list.nextList = page + 1 < m_pages.size() ? toPageName(page + 1) : getStateListNull();
+  for (auto id : m_pages[page]) {
+    list.value.push_back(m_interner->lookup(id));
+  }
+  return list;
+}
+
+} // namespace cledger::dag
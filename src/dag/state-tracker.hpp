@@ -0,0 +1,122 @@
+#ifndef CLEDGER_DAG_STATE_TRACKER_HPP
+#define CLEDGER_DAG_STATE_TRACKER_HPP
+
+#include "dag/edge-state-list.hpp"
+#include "dag/name-interner.hpp"
+#include "storage/ledger-storage.hpp"
+
+#include <unordered_set>
+
+namespace cledger::dag {
+
+const std::string trackerJournalNameHeader = "/32=TrackerJournal";
+
+/**
+ * @brief The global tracker of every EdgeState, as a chain of append-only pages.
+ *
+ * Page 0 is the EdgeStateList named toStateListName(globalTracker), the one a single-list
+ * tracker used, the next ones are /32=EdgeStateList/page/<n>. Each page links to the
+ * next one through nextList and the tail links to getStateListNull(). Readers walk the
+ * chain from page 0, each page being an ordinary internal object.
+ *
+ * The pages held in memory, as IDs, are authoritative: queries are served from them
+ * and storage is only written in batches. commit() appends the states added since the
+ * previous commit to a journal, /32=TrackerJournal/<n>, as one write; flush() rewrites
+ * the dirty pages and drops the journal. A restart loads the stored pages, then replays
+ * the journal on top of them.
+ */
+class StateTracker
+{
+public:
+  StateTracker(storage::Interface storageIntf, std::shared_ptr<NameInterner> interner,
+               size_t pageSize = 256);
+
+  /**
+   * @brief Track a state unless it is already.
+   * @return whether the state was new
+   */
+  bool
+  add(const Name& stateName);
+
+  bool
+  contains(const Name& stateName) const;
+
+  size_t
+  size() const
+  {
+    return m_tracked.size();
+  }
+
+  /**
+   * @brief Visit the tracked states, in the order they were added.
+   */
+  template<typename Visitor>
+  void
+  forEach(Visitor&& visit) const
+  {
+    for (const auto& page : m_pages) {
+      for (auto id : page) {
+        visit(m_interner->lookup(id));
+      }
+    }
+  }
+
+  size_t
+  getPageCount() const
+  {
+    return m_pages.size();
+  }
+
+  /**
+   * @brief Encode a page from memory.
+   * @throw std::runtime_error if @p pageName is not a page of the tracker
+   */
+  Block
+  getPage(const Name& pageName) const;
+
+  /**
+   * @brief Whether states were added since the last commit.
+   */
+  bool
+  hasUncommitted() const
+  {
+    return !m_uncommitted.empty();
+  }
+
+  /**
+   * @brief Journal the states added since the last commit.
+   */
+  void
+  commit();
+
+  /**
+   * @brief Write the dirty pages and drop the journal.
+   */
+  void
+  flush();
+
+  static Name
+  toPageName(uint64_t page);
+
+CLEDGER_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  EdgeStateList
+  makePage(uint64_t page) const;
+
+  void
+  loadJournal();
+
+  storage::Interface m_storageIntf;
+  std::shared_ptr<NameInterner> m_interner;
+  size_t m_pageSize;
+  std::unordered_set<NameId> m_tracked;
+  std::vector<std::vector<NameId>> m_pages;
+  // pages that differ from their stored copy
+  std::set<uint64_t> m_dirty;
+  std::vector<NameId> m_uncommitted;
+  // live journal segments are [0, m_journalNext)
+  uint64_t m_journalNext = 0;
+};
+
+} // namespace cledger::dag
+
+#endif // CLEDGER_DAG_STATE_TRACKER_HPP
@@ -0,0 +1,255 @@
+#include "dag/status-index.hpp"
+
+namespace cledger::dag {
+
+enum : uint32_t {
+  TLV_LEDGER_STATUS_TYPE = 441,
+  TLV_LEDGER_STATUS_PENDING = 442,
+  TLV_LEDGER_STATUS_INTERLOCKED = 443,
+  TLV_LEDGER_STATUS_OLDEST_PENDING_T = 444,
+  TLV_LEDGER_STATUS_LATENCY_SAMPLES = 445,
+  TLV_LEDGER_STATUS_MIN_LATENCY = 446,
+  TLV_LEDGER_STATUS_MEAN_LATENCY = 447,
+  TLV_LEDGER_STATUS_MAX_LATENCY = 448,
+};
+
+enum : uint32_t {
+  TLV_STATUS_SNAPSHOT = 471,
+  TLV_STATUS_SNAPSHOT_INTERLOCKED = 472,
+  TLV_STATUS_SNAPSHOT_LATENCY_SAMPLES = 473,
+  TLV_STATUS_SNAPSHOT_LATENCY_SUM = 474,
+  TLV_STATUS_SNAPSHOT_MIN_LATENCY = 475,
+  TLV_STATUS_SNAPSHOT_MAX_LATENCY = 476,
+  TLV_STATUS_SNAPSHOT_PENDING = 477,
+  TLV_STATUS_SNAPSHOT_CREATED = 478,
+};
+
+Block
+encodeLedgerStatus(const LedgerStatus& status)
+{
+  Block block(TLV_LEDGER_STATUS_TYPE);
+  block.push_back(ndn::makeNonNegativeIntegerBlock(TLV_LEDGER_STATUS_PENDING, status.pending));
+  block.push_back(ndn::makeNonNegativeIntegerBlock(TLV_LEDGER_STATUS_INTERLOCKED, status.interlocked));
+  if (!status.oldestPending.empty()) {
+    block.push_back(status.oldestPending.wireEncode());
+    block.push_back(ndn::makeStringBlock(TLV_LEDGER_STATUS_OLDEST_PENDING_T,
+                                         time::toIsoString(status.oldestPendingCreated)));
+  }
+  block.push_back(ndn::makeNonNegativeIntegerBlock(TLV_LEDGER_STATUS_LATENCY_SAMPLES, status.latencySamples));
+  block.push_back(ndn::makeNonNegativeIntegerBlock(TLV_LEDGER_STATUS_MIN_LATENCY, status.minLatency.count()));
+  block.push_back(ndn::makeNonNegativeIntegerBlock(TLV_LEDGER_STATUS_MEAN_LATENCY, status.meanLatency.count()));
+  block.push_back(ndn::makeNonNegativeIntegerBlock(TLV_LEDGER_STATUS_MAX_LATENCY, status.maxLatency.count()));
+  block.encode();
+  return block;
+}
+
+LedgerStatus
+decodeLedgerStatus(const Block& block)
+{
+  LedgerStatus status;
+  block.parse();
+  if (block.type() != TLV_LEDGER_STATUS_TYPE) {
+    NDN_THROW(std::runtime_error("TLV Type is incorrect"));
+  }
+  for (const auto &item : block.elements()) {
+    switch (item.type()) {
+      case TLV_LEDGER_STATUS_PENDING:
+        status.pending = ndn::readNonNegativeInteger(item);
+        break;
+      case TLV_LEDGER_STATUS_INTERLOCKED:
+        status.interlocked = ndn::readNonNegativeInteger(item);
+        break;
+      case ndn::tlv::Name:
+        status.oldestPending = Name(item);
+        break;
+      case TLV_LEDGER_STATUS_OLDEST_PENDING_T:
+        status.oldestPendingCreated = time::fromIsoString(ndn::readString(item));
+        break;
+      case TLV_LEDGER_STATUS_LATENCY_SAMPLES:
+        status.latencySamples = ndn::readNonNegativeInteger(item);
+        break;
+      case TLV_LEDGER_STATUS_MIN_LATENCY:
+        status.minLatency = time::milliseconds(ndn::readNonNegativeInteger(item));
+        break;
+      case TLV_LEDGER_STATUS_MEAN_LATENCY:
+        status.meanLatency = time::milliseconds(ndn::readNonNegativeInteger(item));
+        break;
+      case TLV_LEDGER_STATUS_MAX_LATENCY:
+        status.maxLatency = time::milliseconds(ndn::readNonNegativeInteger(item));
+        break;
+      default:
+        if (ndn::tlv::isCriticalType(item.type())) {
+          NDN_THROW(std::runtime_error("Unrecognized TLV Type: " + std::to_string(item.type())));
+        }
+        break;
+    }
+  }
+  return status;
+}
+
+std::ostream&
+operator<<(std::ostream& os, const LedgerStatus& status)
+{
+  os << "Pending Records: " << status.pending << "\n";
+  os << "Interlocked Records: " << status.interlocked << "\n";
+  if (!status.oldestPending.empty()) {
+    os << "   Oldest Pending: " << status.oldestPending
+       << " since " << ndn::time::toIsoString(status.oldestPendingCreated) << "\n";
+  }
+  if (status.latencySamples > 0) {
+    os << "   Interlock Latency (" << status.latencySamples << " records): min "
+       << status.minLatency.count() << " ms, mean " << status.meanLatency.count()
+       << " ms, max " << status.maxLatency.count() << " ms\n";
+  }
+  return os;
+}
+
+StatusIndex::StatusIndex(std::shared_ptr<NameInterner> interner)
+  : m_interner(std::move(interner))
+{
+}
+
+void
+StatusIndex::addPending(const Name& stateName, time::system_clock::time_point created)
+{
+  auto id = m_interner->intern(stateName);
+  if (m_interlocked.count(id) > 0 || !m_pending.emplace(id, created).second) {
+    return;
+  }
+  m_pendingByAge.emplace(created, id);
+}
+
+void
+StatusIndex::markInterlocked(const Name& stateName, time::system_clock::time_point interlocked)
+{
+  auto id = m_interner->intern(stateName);
+  if (!m_interlocked.emplace(id, interlocked).second) {
+    return;
+  }
+  auto it = m_pending.find(id);
+  if (it == m_pending.end()) {
+    // e.g., interlocked before a restart, no creation time to measure from
+    return;
+  }
+  auto latency = std::max(time::nanoseconds(0), time::nanoseconds(interlocked - it->second));
+  m_latencySamples++;
+  m_latencySum += latency;
+  m_minLatency = std::min(m_minLatency, latency);
+  m_maxLatency = std::max(m_maxLatency, latency);
+  m_pendingByAge.erase({it->second, id});
+  m_pending.erase(it);
+}
+
+bool
+StatusIndex::isPending(const Name& stateName) const
+{
+  auto id = m_interner->find(stateName);
+  return id && m_pending.count(*id) > 0;
+}
+
+optional<time::system_clock::time_point>
+StatusIndex::getInterlockTime(const Name& stateName) const
+{
+  auto id = m_interner->find(stateName);
+  if (!id) {
+    return nullopt;
+  }
+  auto it = m_interlocked.find(*id);
+  if (it == m_interlocked.end()) {
+    return nullopt;
+  }
+  return it->second;
+}
+
+LedgerStatus
+StatusIndex::getStatus() const
+{
+  LedgerStatus status;
+  status.pending = m_pending.size();
+  if (!m_pendingByAge.empty()) {
+    status.oldestPending = m_interner->lookup(m_pendingByAge.begin()->second);
+    status.oldestPendingCreated = m_pendingByAge.begin()->first;
+  }
+  status.interlocked = getInterlockedCount();
+  status.latencySamples = m_latencySamples;
+  if (m_latencySamples > 0) {
+    status.minLatency = time::duration_cast<time::milliseconds>(m_minLatency);
+    status.meanLatency = time::duration_cast<time::milliseconds>(m_latencySum / m_latencySamples);
+    status.maxLatency = time::duration_cast<time::milliseconds>(m_maxLatency);
+  }
+  return status;
+}
+
+std::vector<Name>
+StatusIndex::listPending() const
+{
+  std::vector<Name> names;
+  names.reserve(m_pendingByAge.size());
+  for (const auto& [created, id] : m_pendingByAge) {
+    names.push_back(m_interner->lookup(id));
+  }
+  return names;
+}
+
+Block
+StatusIndex::encodeSnapshot() const
+{
+  Block block(TLV_STATUS_SNAPSHOT);
+  block.push_back(ndn::makeNonNegativeIntegerBlock(TLV_STATUS_SNAPSHOT_INTERLOCKED, getInterlockedCount()));
+  block.push_back(ndn::makeNonNegativeIntegerBlock(TLV_STATUS_SNAPSHOT_LATENCY_SAMPLES, m_latencySamples));
+  block.push_back(ndn::makeNonNegativeIntegerBlock(TLV_STATUS_SNAPSHOT_LATENCY_SUM, m_latencySum.count()));
+  block.push_back(ndn::makeNonNegativeIntegerBlock(TLV_STATUS_SNAPSHOT_MIN_LATENCY, m_minLatency.count()));
+  block.push_back(ndn::makeNonNegativeIntegerBlock(TLV_STATUS_SNAPSHOT_MAX_LATENCY, m_maxLatency.count()));
+  for (const auto& [created, id] : m_pendingByAge) {
+    Block pending(TLV_STATUS_SNAPSHOT_PENDING);
+    pending.push_back(m_interner->lookup(id).wireEncode());
+    pending.push_back(ndn::makeNonNegativeIntegerBlock(TLV_STATUS_SNAPSHOT_CREATED,
+                                                       time::toUnixTimestamp(created).count()));
+    pending.encode();
+    block.push_back(pending);
+  }
+  block.encode();
+  return block;
+}
+
+void
+StatusIndex::loadSnapshot(const Block& block)
+{
+  block.parse();
+  if (block.type() != TLV_STATUS_SNAPSHOT) {
+    NDN_THROW(std::runtime_error("TLV Type is incorrect"));
+  }
+  for (const auto& item : block.elements()) {
+    switch (item.type()) {
+      case TLV_STATUS_SNAPSHOT_INTERLOCKED:
+        m_restoredInterlocked = ndn::readNonNegativeInteger(item);
+        break;
+      case TLV_STATUS_SNAPSHOT_LATENCY_SAMPLES:
+        m_latencySamples = ndn::readNonNegativeInteger(item);
+        break;
+      case TLV_STATUS_SNAPSHOT_LATENCY_SUM:
+        m_latencySum = time::nanoseconds(ndn::readNonNegativeInteger(item));
+        break;
+      case TLV_STATUS_SNAPSHOT_MIN_LATENCY:
+        m_minLatency = time::nanoseconds(ndn::readNonNegativeInteger(item));
+        break;
+      case TLV_STATUS_SNAPSHOT_MAX_LATENCY:
+        m_maxLatency = time::nanoseconds(ndn::readNonNegativeInteger(item));
+        break;
+      case TLV_STATUS_SNAPSHOT_PENDING: {
+        item.parse();
+        auto created = time::fromUnixTimestamp(
+          time::milliseconds(ndn::readNonNegativeInteger(item.get(TLV_STATUS_SNAPSHOT_CREATED))));
+        addPending(Name(item.get(ndn::tlv::Name)), created);
+        break;
+      }
+      default:
+        if (ndn::tlv::isCriticalType(item.type())) {
+          NDN_THROW(std::runtime_error("Unrecognized TLV Type: " + std::to_string(item.type())));
+        }
+        break;
+    }
+  }
+}
+
+} // namespace cledger::dag
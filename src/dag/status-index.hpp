@@ -0,0 +1,123 @@
+#ifndef CLEDGER_DAG_STATUS_INDEX_HPP
+#define CLEDGER_DAG_STATUS_INDEX_HPP
+
+#include "dag/name-interner.hpp"
+
+#include <unordered_map>
+
+namespace cledger::dag {
+
+const std::string statusNameHeader = "/32=LedgerStatus";
+const std::string statusSnapshotName = "/32=StatusSnapshot";
+
+/**
+ * @brief Summary of the tracked records, as served to ndncledger-ledger-status.
+ */
+struct LedgerStatus
+{
+  uint64_t pending = 0;
+  uint64_t interlocked = 0;
+  // empty when nothing is pending
+  Name oldestPending;
+  time::system_clock::time_point oldestPendingCreated;
+  // over the records whose creation was seen by this ledger
+  uint64_t latencySamples = 0;
+  time::milliseconds minLatency{0};
+  time::milliseconds meanLatency{0};
+  time::milliseconds maxLatency{0};
+};
+
+Block
+encodeLedgerStatus(const LedgerStatus& status);
+
+LedgerStatus
+decodeLedgerStatus(const Block& block);
+
+std::ostream&
+operator<<(std::ostream& os, const LedgerStatus& status);
+
+/**
+ * @brief Records partitioned by status, so that counts are O(1) and the oldest pending
+ * record is O(log n) instead of fetching every EdgeState.
+ *
+ * Pending records are kept ordered by creation time, interlocked ones with their
+ * interlock time; the interlock latency is aggregated as records move over.
+ *
+ * A snapshot keeps the counts, the aggregates and the pending records, so that a
+ * restart reads one block instead of every EdgeState. Interlocked records loaded from
+ * it are only counted.
+ */
+class StatusIndex
+{
+public:
+  explicit
+  StatusIndex(std::shared_ptr<NameInterner> interner);
+
+  /**
+   * @brief Index a new record as pending, unless it is already indexed.
+   */
+  void
+  addPending(const Name& stateName, time::system_clock::time_point created);
+
+  /**
+   * @brief Move a record to the interlocked set, indexing it if it was unknown.
+   */
+  void
+  markInterlocked(const Name& stateName, time::system_clock::time_point interlocked);
+
+  size_t
+  getPendingCount() const
+  {
+    return m_pending.size();
+  }
+
+  size_t
+  getInterlockedCount() const
+  {
+    return m_restoredInterlocked + m_interlocked.size();
+  }
+
+  bool
+  isPending(const Name& stateName) const;
+
+  optional<time::system_clock::time_point>
+  getInterlockTime(const Name& stateName) const;
+
+  LedgerStatus
+  getStatus() const;
+
+  /**
+   * @brief The pending records, oldest first.
+   */
+  std::vector<Name>
+  listPending() const;
+
+  Block
+  encodeSnapshot() const;
+
+  /**
+   * @brief Start from a snapshot taken by encodeSnapshot().
+   * @pre nothing is indexed yet
+   * @throw std::runtime_error @p block is not a snapshot
+   */
+  void
+  loadSnapshot(const Block& block);
+
+private:
+  std::shared_ptr<NameInterner> m_interner;
+  std::unordered_map<NameId, time::system_clock::time_point> m_pending;
+  // the same records, oldest first
+  std::set<std::pair<time::system_clock::time_point, NameId>> m_pendingByAge;
+  std::unordered_map<NameId, time::system_clock::time_point> m_interlocked;
+  // interlocked before the snapshot was taken, not indexed by Name
+  uint64_t m_restoredInterlocked = 0;
+
+  uint64_t m_latencySamples = 0;
+  time::nanoseconds m_latencySum{0};
+  time::nanoseconds m_minLatency = time::nanoseconds::max();
+  time::nanoseconds m_maxLatency{0};
+};
+
+} // namespace cledger::dag
+
+#endif // CLEDGER_DAG_STATUS_INDEX_HPP
@@ -0,0 +1,25 @@
+#include "dag/tip-selector-all.hpp"
+
+namespace cledger::dag::tip {
+
+const std::string TipSelectorAll::SELECTOR_TYPE = "tips-all";
+CLEDGER_REGISTER_TIP_SELECTOR(TipSelectorAll);
+
+TipSelectorAll::TipSelectorAll(size_t maxFanOut)
+  : TipSelector(maxFanOut)
+{
+}
+
+std::list<Name>
+TipSelectorAll::select(const std::vector<EdgeState>& tips, const Name& producer)
+{
+  std::list<Name> ret;
+  for (auto& tip : tips) {
+    if (m_maxFanOut > 0 && ret.size() >= m_maxFanOut) {
+      break;
+    }
+    ret.push_back(fromStateName(tip.stateName));
+  }
+  return ret;
+}
+} // namespace cledger::dag::tip
@@ -0,0 +1,22 @@
+#ifndef CLEDGER_DAG_TIP_SELECTOR_ALL_HPP
+#define CLEDGER_DAG_TIP_SELECTOR_ALL_HPP
+
+#include "tip-selector.hpp"
+namespace cledger::dag::tip {
+
+/**
+ * @brief Points to every tip, in name order, up to the max fan-out.
+ */
+class TipSelectorAll : public TipSelector
+{
+public:
+  TipSelectorAll(size_t maxFanOut = 0);
+  const static std::string SELECTOR_TYPE;
+
+  std::list<Name>
+  select(const std::vector<EdgeState>& tips, const Name& producer) override;
+};
+
+} // namespace cledger::dag::tip
+
+#endif // CLEDGER_DAG_TIP_SELECTOR_ALL_HPP
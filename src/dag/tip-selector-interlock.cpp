@@ -0,0 +1,70 @@
+#include "dag/tip-selector-interlock.hpp"
+
+#include <algorithm>
+
+namespace cledger::dag::tip {
+
+const std::string TipSelectorInterlock::SELECTOR_TYPE = "tips-interlock";
+CLEDGER_REGISTER_TIP_SELECTOR(TipSelectorInterlock);
+
+TipSelectorInterlock::TipSelectorInterlock(size_t maxFanOut)
+  : TipSelector(maxFanOut)
+{
+}
+
+std::list<Name>
+TipSelectorInterlock::select(const std::vector<EdgeState>& tips, const Name& producer)
+{
+  auto older = [] (const EdgeState* a, const EdgeState* b) {
+    return a->created != b->created ? a->created < b->created : a->stateName < b->stateName;
+  };
+
+  // tips of each producer, oldest first
+  std::map<Name, std::vector<const EdgeState*>> byProducer;
+  for (auto& tip : tips) {
+    byProducer[fromStateName(tip.stateName).getPrefix(-1)].push_back(&tip);
+  }
+  std::vector<std::vector<const EdgeState*>*> queues;
+  std::vector<const EdgeState*>* own = nullptr;
+  for (auto& p : byProducer) {
+    std::sort(p.second.begin(), p.second.end(), older);
+    if (p.first == producer) {
+      own = &p.second;
+    }
+    else {
+      queues.push_back(&p.second);
+    }
+  }
+  std::sort(queues.begin(), queues.end(), [&older] (auto a, auto b) {
+    return older(a->front(), b->front());
+  });
+
+  std::list<Name> ret;
+  auto isFull = [this, &ret] { return m_maxFanOut > 0 && ret.size() >= m_maxFanOut; };
+  for (size_t round = 0; !isFull(); round++) {
+    bool picked = false;
+    for (auto q : queues) {
+      if (isFull()) {
+        break;
+      }
+      if (round < q->size()) {
+        ret.push_back(fromStateName((*q)[round]->stateName));
+        picked = true;
+      }
+    }
+    if (!picked) {
+      break;
+    }
+  }
+  // own records only fill what is left
+  if (own != nullptr) {
+    for (auto tip : *own) {
+      if (isFull()) {
+        break;
+      }
+      ret.push_back(fromStateName(tip->stateName));
+    }
+  }
+  return ret;
+}
+} // namespace cledger::dag::tip
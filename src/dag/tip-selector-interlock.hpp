@@ -0,0 +1,27 @@
+#ifndef CLEDGER_DAG_TIP_SELECTOR_INTERLOCK_HPP
+#define CLEDGER_DAG_TIP_SELECTOR_INTERLOCK_HPP
+
+#include "tip-selector.hpp"
+namespace cledger::dag::tip {
+
+/**
+ * @brief Picks the tips that get closest to being interlocked.
+ *
+ * Tips of other producers are taken round-robin, oldest first, starting with
+ * the producer whose oldest tip has waited the longest; this ledger's own
+ * records only fill the remaining fan-out. A tip pointed to by another producer
+ * gains a witness, and the oldest tips are the furthest behind the threshold.
+ */
+class TipSelectorInterlock : public TipSelector
+{
+public:
+  TipSelectorInterlock(size_t maxFanOut = 0);
+  const static std::string SELECTOR_TYPE;
+
+  std::list<Name>
+  select(const std::vector<EdgeState>& tips, const Name& producer) override;
+};
+
+} // namespace cledger::dag::tip
+
+#endif // CLEDGER_DAG_TIP_SELECTOR_INTERLOCK_HPP
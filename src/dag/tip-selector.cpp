@@ -0,0 +1,19 @@
+#include "dag/tip-selector.hpp"
+
+namespace cledger::dag::tip {
+
+std::unique_ptr<TipSelector>
+TipSelector::createTipSelector(const std::string& tipSelectorType, size_t maxFanOut)
+{
+  TipSelectorFactory& factory = getFactory();
+  auto i = factory.find(tipSelectorType);
+  return i == factory.end() ? nullptr : i->second(maxFanOut);
+}
+
+TipSelector::TipSelectorFactory&
+TipSelector::getFactory()
+{
+  static TipSelector::TipSelectorFactory factory;
+  return factory;
+}
+} // namespace cledger::dag::tip
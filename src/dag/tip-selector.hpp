@@ -0,0 +1,71 @@
+#ifndef CLEDGER_DAG_TIP_SELECTOR_HPP
+#define CLEDGER_DAG_TIP_SELECTOR_HPP
+
+#include "record.hpp"
+#include "dag/edge-state.hpp"
+namespace cledger::dag::tip {
+
+/**
+ * @brief Chooses the records that a new record points to.
+ *
+ * Tips are the states that no record points to yet. A selector picks at most
+ * maxFanOut of them (0 for no bound), the rest stay tips for later records.
+ */
+class TipSelector
+{
+public:
+  explicit
+  TipSelector(size_t maxFanOut = 0)
+    : m_maxFanOut(maxFanOut)
+  {
+  }
+
+  /**
+   * @param tips states without descendants
+   * @param producer name prefix of the records published by this ledger
+   * @return record names to point to
+   */
+  virtual std::list<Name>
+  select(const std::vector<EdgeState>& tips, const Name& producer) = 0;
+
+public:
+  template<class TipSelectorType>
+  static void
+  registerTipSelector(const std::string& tipSelectorType = TipSelectorType::SELECTOR_TYPE)
+  {
+    TipSelectorFactory& factory = getFactory();
+    factory[tipSelectorType] = [] (size_t maxFanOut) {
+      return std::make_unique<TipSelectorType>(maxFanOut);
+    };
+  }
+
+  static std::unique_ptr<TipSelector>
+  createTipSelector(const std::string& tipSelectorType, size_t maxFanOut);
+
+  virtual
+  ~TipSelector() = default;
+
+protected:
+  size_t m_maxFanOut;
+
+private:
+  using TipSelectorCreateFunc = std::function<std::unique_ptr<TipSelector> (size_t)>;
+  using TipSelectorFactory = std::map<std::string, TipSelectorCreateFunc>;
+
+  static TipSelectorFactory&
+  getFactory();
+};
+
+#define CLEDGER_REGISTER_TIP_SELECTOR(C)                             \
+static class Cledger ## C ## TipSelectorRegistrationClass            \
+{                                                                \
+public:                                                          \
+  Cledger ## C ## TipSelectorRegistrationClass()                     \
+  {                                                              \
+    ::cledger::dag::tip::TipSelector::registerTipSelector<C>();      \
+  }                                                              \
+} g_Cledger ## C ## TipSelectorRegistrationVariable
+
+} // namespace cledger::dag::tip
+
+#endif // CLEDGER_DAG_TIP_SELECTOR_HPP
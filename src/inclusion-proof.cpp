@@ -0,0 +1,92 @@
+#include "inclusion-proof.hpp"
+
+namespace cledger {
+
+enum : uint32_t {
+  TLV_TREE_HEAD = 221,
+  TLV_TREE_SIZE = 222,
+  TLV_TREE_ROOT = 223,
+  TLV_INCLUSION_PROOF = 224,
+  TLV_LEAF_INDEX = 225,
+  TLV_PATH_NODE = 226,
+};
+
+Block
+encodeTreeHead(const TreeHead& treeHead)
+{
+  Block block(TLV_TREE_HEAD);
+  block.push_back(ndn::makeNonNegativeIntegerBlock(TLV_TREE_SIZE, treeHead.treeSize));
+  block.push_back(ndn::makeBinaryBlock(TLV_TREE_ROOT, treeHead.root));
+  block.encode();
+  return block;
+}
+
+TreeHead
+decodeTreeHead(const Block& block)
+{
+  TreeHead treeHead;
+  block.parse();
+  if (block.type() != TLV_TREE_HEAD) {
+    NDN_THROW(std::runtime_error("TLV Type is incorrect"));
+  }
+  for (const auto &item : block.elements()) {
+    switch (item.type()) {
+      case TLV_TREE_SIZE:
+        treeHead.treeSize = ndn::readNonNegativeInteger(item);
+        break;
+      case TLV_TREE_ROOT:
+        treeHead.root = Buffer(item.value_begin(), item.value_end());
+        break;
+      default:
+        if (ndn::tlv::isCriticalType(item.type())) {
+          NDN_THROW(std::runtime_error("Unrecognized TLV Type: " + std::to_string(item.type())));
+        }
+        break;
+    }
+  }
+  return treeHead;
+}
+
+Block
+encodeInclusionProof(const InclusionProof& proof)
+{
+  Block block(TLV_INCLUSION_PROOF);
+  block.push_back(ndn::makeNonNegativeIntegerBlock(TLV_LEAF_INDEX, proof.leafIndex));
+  block.push_back(ndn::makeNonNegativeIntegerBlock(TLV_TREE_SIZE, proof.treeSize));
+  for (auto& node : proof.path) {
+    block.push_back(ndn::makeBinaryBlock(TLV_PATH_NODE, node));
+  }
+  block.encode();
+  return block;
+}
+
+InclusionProof
+decodeInclusionProof(const Block& block)
+{
+  InclusionProof proof;
+  block.parse();
+  if (block.type() != TLV_INCLUSION_PROOF) {
+    NDN_THROW(std::runtime_error("TLV Type is incorrect"));
+  }
+  for (const auto &item : block.elements()) {
+    switch (item.type()) {
+      case TLV_LEAF_INDEX:
+        proof.leafIndex = ndn::readNonNegativeInteger(item);
+        break;
+      case TLV_TREE_SIZE:
+        proof.treeSize = ndn::readNonNegativeInteger(item);
+        break;
+      case TLV_PATH_NODE:
+        proof.path.emplace_back(item.value_begin(), item.value_end());
+        break;
+      default:
+        if (ndn::tlv::isCriticalType(item.type())) {
+          NDN_THROW(std::runtime_error("Unrecognized TLV Type: " + std::to_string(item.type())));
+        }
+        break;
+    }
+  }
+  return proof;
+}
+
+} // namespace cledger
@@ -0,0 +1,45 @@
+#ifndef CLEDGER_INCLUSION_PROOF_HPP
+#define CLEDGER_INCLUSION_PROOF_HPP
+
+#include "cledger-common.hpp"
+
+namespace cledger {
+
+/**
+ * @brief Size and root of the ledger's Merkle log, signed as a Data by the ledger.
+ */
+struct TreeHead
+{
+  uint64_t treeSize = 0;
+  Buffer root;
+};
+
+Block
+encodeTreeHead(const TreeHead& treeHead);
+
+TreeHead
+decodeTreeHead(const Block& block);
+
+/**
+ * @brief Audit path of one leaf in a tree of treeSize leaves.
+ *
+ * A proof-mode query response carries the signed tree head Data followed by
+ * the proof for the leaf of the queried Data, whose leaf data is the wire
+ * encoding of the Data's full name (ie. with its implicit digest).
+ */
+struct InclusionProof
+{
+  uint64_t leafIndex = 0;
+  uint64_t treeSize = 0;
+  std::vector<Buffer> path;
+};
+
+Block
+encodeInclusionProof(const InclusionProof& proof);
+
+InclusionProof
+decodeInclusionProof(const Block& block);
+
+} // namespace cledger
+
+#endif // CLEDGER_INCLUSION_PROOF_HPP
@@ -14,6 +14,8 @@ const std::string CONFIG_RECORD_ZONES = "record-zones";
 const std::string CONFIG_STORAGE = "storage";
 const std::string CONFIG_STORAGE_TYPE = "storage-type";
 const std::string CONFIG_STORAGE_PATH = "storage-path";
+const std::string CONFIG_STORAGE_TRACKER_FLUSH_PERIOD = "tracker-flush-period";
+const std::string CONFIG_STORAGE_CERT_FILTER_CAPACITY = "cert-filter-capacity";
 const std::string CONFIG_INTERLOCK_POLICY = "interlock-policy";
 const std::string CONFIG_INTERLOCK_POLICY_TYPE = "policy-type";
 const std::string CONFIG_INTERLOCK_POLICY_THRESHOLD = "policy-threshold";
@@ -23,9 +25,21 @@ const std::string CONFIG_SYNC = "sync";
 const std::string CONFIG_SYNC_INTEREST_SIGNING = "interest-signing";
 const std::string CONFIG_SYNC_DATA_SIGNING = "data-signing";
 
+const std::string CONFIG_DAG = "dag";
+const std::string CONFIG_DAG_WORKER_THREAD = "worker-thread";
+const std::string CONFIG_DAG_QUEUE_CAPACITY = "queue-capacity";
+const std::string CONFIG_DAG_TIP_SELECTOR = "tip-selector";
+const std::string CONFIG_DAG_MAX_FAN_OUT = "max-fan-out";
+const std::string CONFIG_DAG_EPOCH_SIZE = "epoch-size";
+const std::string CONFIG_DAG_BATCH_WINDOW = "batch-window";
+
 const std::string CONFIG_SEGMENT = "segment";
 const std::string CONFIG_SEGMENT_SIZE_MAX = "max-segment-size";
 const std::string CONFIG_SEGMENT_SESSION_LENGTH = "session-length";
+const std::string CONFIG_SEGMENT_MANIFEST = "manifest";
+const std::string CONFIG_SEGMENT_RESPONSE_CACHE_SIZE = "response-cache-size";
+const std::string CONFIG_SEGMENT_NACK_CACHE_SIZE = "nack-cache-size";
+const std::string CONFIG_SEGMENT_SESSION_MEMORY_BUDGET = "session-memory-budget";
 
 void
 LedgerConfig::load(const std::string& fileName)
@@ -67,8 +81,10 @@ LedgerConfig::load(const std::string& fileName)
   // Storage
   auto storageConfig = configJson.get_child_optional(CONFIG_STORAGE);
   if (storageConfig) {
-    storageConfig->get(CONFIG_STORAGE_TYPE, "storage-memory");
-    storageConfig->get(CONFIG_STORAGE_PATH, "");
+    storageType = storageConfig->get(CONFIG_STORAGE_TYPE, "storage-memory");
+    storagePath = storageConfig->get(CONFIG_STORAGE_PATH, "");
+    trackerFlushPeriod = time::seconds(storageConfig->get(CONFIG_STORAGE_TRACKER_FLUSH_PERIOD, 10));
+    certFilterCapacity = storageConfig->get(CONFIG_STORAGE_CERT_FILTER_CAPACITY, 1000000);
   }
 
   // Interlock policy
@@ -103,11 +119,25 @@ LedgerConfig::load(const std::string& fileName)
   else {
     NDN_THROW(std::runtime_error("Cannot parse sync config from the config file"));
   }
+  // DAG engine
+  auto dagConfig = configJson.get_child_optional(CONFIG_DAG);
+  if (dagConfig) {
+    dagWorkerThread = dagConfig->get(CONFIG_DAG_WORKER_THREAD, false);
+    dagQueueCapacity = dagConfig->get(CONFIG_DAG_QUEUE_CAPACITY, 1024);
+    tipSelectorType = dagConfig->get(CONFIG_DAG_TIP_SELECTOR, "tips-all");
+    maxFanOut = dagConfig->get(CONFIG_DAG_MAX_FAN_OUT, 0);
+    epochSize = dagConfig->get(CONFIG_DAG_EPOCH_SIZE, 0);
+    batchWindow = dagConfig->get(CONFIG_DAG_BATCH_WINDOW, 0);
+  }
   // Segmentation
   auto segmentConfig = configJson.get_child_optional(CONFIG_SEGMENT);
   if (segmentConfig) {
     maxSegmentSize = segmentConfig->get(CONFIG_SEGMENT_SIZE_MAX, 8000);
+    segmentManifest = segmentConfig->get(CONFIG_SEGMENT_MANIFEST, false);
     sessionLength = time::seconds(segmentConfig->get(CONFIG_SEGMENT_SESSION_LENGTH, 30));
+    responseCacheSize = segmentConfig->get(CONFIG_SEGMENT_RESPONSE_CACHE_SIZE, 256);
+    nackCacheSize = segmentConfig->get(CONFIG_SEGMENT_NACK_CACHE_SIZE, 1024);
+    sessionMemoryBudget = segmentConfig->get(CONFIG_SEGMENT_SESSION_MEMORY_BUDGET, 64 * 1024 * 1024);
   }
 }
 
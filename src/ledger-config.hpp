@@ -18,12 +18,26 @@ namespace cledger::ledger {
  *  [
  *    "", ""
  *  ]
- *  "storage": ""
+ *  "storage":
+ *  [
+ *    "storage-type": "",
+ *    "storage-path": "",
+ *    "tracker-flush-period": "" (in seconds, between rewrites of the global tracker pages)
+ *  ]
  *  "interlock-policy":
  *  [
  *    "policy-type": ""
  *    "policy-threshold": ""
  *  ]
+ *  "dag":
+ *  [
+ *    "worker-thread": "", (true to run the DAG engine on its own thread)
+ *    "queue-capacity": "",
+ *    "tip-selector": "", (tips-all, the default, or tips-interlock)
+ *    "max-fan-out": "", (max pointers of a new record, 0 for no bound, the default)
+ *    "epoch-size": "", (interlocked records per checkpoint, 0 for no checkpoints)
+ *    "batch-window": "" (records re-scored at once by the batch engine, 0 to disable it)
+ *  ]
  * }
  */
 class LedgerConfig
@@ -45,6 +59,9 @@ public:
   std::vector<Name> recordZones;
   std::string storageType = "storage-memory";
   std::string storagePath = "";
+  ndn::time::milliseconds trackerFlushPeriod = time::seconds(10);
+  // certificates the Bloom filter of known names is sized for
+  size_t certFilterCapacity = 1000000;
   std::string policyType = "policy-descendants";
   uint32_t policyThreshold = 1;
   std::string schemaFile;
@@ -52,8 +69,25 @@ public:
   ndn::security::SigningInfo interestSigner;
   ndn::security::SigningInfo dataSigner;
 
+  bool dagWorkerThread = false;
+  size_t dagQueueCapacity = 1024;
+  std::string tipSelectorType = "tips-all";
+  size_t maxFanOut = 0;
+  // interlocked records per epoch checkpoint, 0 disables checkpoints
+  size_t epochSize = 0;
+  // recent records scored together by an InterlockEngine, 0 disables batch evaluation
+  size_t batchWindow = 0;
+
   size_t maxSegmentSize = 8000;
+  // one signed manifest per response, DigestSha256 on the other segments
+  bool segmentManifest = false;
   ndn::time::milliseconds sessionLength = time::seconds(30);
+  // bytes of response segments held for all sessions
+  size_t sessionMemoryBudget = 64 * 1024 * 1024;
+  // cached record query responses, 0 disables the cache
+  size_t responseCacheSize = 256;
+  // signed Nacks reused within their freshness period, 0 disables the cache
+  size_t nackCacheSize = 1024;
 };
 
 } // namespace cledger::ledger
@@ -3,7 +3,10 @@
 #include "dag/interlock-policy-descendants.hpp"
 #include "dag/edge-state-list.hpp"
 #include "dag/payload-map.hpp"
-#include "util/segment/producer.hpp"
+#include "inclusion-proof.hpp"
+#include "batch-query.hpp"
+#include "util/sha256-batch.hpp"
+#include "util/wire-encoder.hpp"
 
 #include <ndn-cxx/security/signing-helpers.hpp>
 #include <ndn-cxx/security/verification-helpers.hpp>
@@ -19,6 +22,13 @@ NDN_LOG_INIT(cledger.benchmark.ledger);
 NDN_LOG_INIT(cledger.ledger);
 #endif
 
+// replies carry no Data, and checkpoints a commitment known by its state name only
+static bool
+carriesCertificate(const Record& record)
+{
+  return record.getType() != tlv::REPLY_RECORD && record.getType() != tlv::CHECKPOINT_RECORD;
+}
+
 LedgerModule::LedgerModule(ndn::Face& face, ndn::KeyChain& keyChain, const std::string& configPath, time::milliseconds replyPeriod)
   : m_face(face)
   , m_keyChain(keyChain)
@@ -27,7 +37,12 @@ LedgerModule::LedgerModule(ndn::Face& face, ndn::KeyChain& keyChain, const std::
   // load the config and create storage
   m_config.load(configPath);
   m_instancePrefix = Name(m_config.ledgerPrefix).append(m_config.instanceSuffix);
+  m_batchPrefix = Name(m_config.ledgerPrefix).append("LEDGER").append("BATCH");
   m_validator.load(m_config.schemaFile);
+  util::segment::SegmentServer::Options serverOpts;
+  serverOpts.sessionLength = m_config.sessionLength;
+  serverOpts.memoryBudget = m_config.sessionMemoryBudget;
+  m_segmentServer = std::make_unique<util::segment::SegmentServer>(m_face, serverOpts);
   registerPrefix(); 
   
   Name topic = Name(m_config.ledgerPrefix).append("LEDGER").append("append");
@@ -44,20 +59,43 @@ LedgerModule::LedgerModule(ndn::Face& face, ndn::KeyChain& keyChain, const std::
 
   // dag engine
   m_policy = dag::policy::InterlockPolicy::createInterlockPolicy(m_config.policyType, "");
-  m_dag = std::make_unique<dag::DagModule>(m_storage->getInterface(), m_policy->getInterface());
-
-  // initialize a global edge state list
-  dag::EdgeStateList statesTracker;
-  statesTracker.key = dag::globalTracker;
-  statesTracker.listName = dag::toStateListName(statesTracker.key);
-  statesTracker.nextList = dag::getStateListNull();
-  try {
-    m_storage->addBlock(statesTracker.listName, dag::encodeEdgeStateList(statesTracker));
+  if (m_policy == nullptr) {
+    NDN_THROW(std::runtime_error("Unknown interlock policy " + m_config.policyType));
+  }
+  m_dag = std::make_unique<dag::DagModule>(m_storage->getInterface(), *m_policy);
+  if (m_config.batchWindow > 0) {
+    m_interlockEngine = std::make_unique<dag::policy::InterlockEngine>(m_config.policyType);
+    m_dag->setBatchEvaluater([engine = m_interlockEngine.get()] (const auto& window) {
+                               return engine->evaluate(window);
+                             },
+                             m_config.batchWindow);
   }
-  catch (const std::runtime_error& e){
-    NDN_LOG_WARN("Read from an existing global tracker");
+  // pick up the frontier left by a previous run
+  m_dag->restore();
+  m_interner = m_dag->getInterner();
+  m_merkleLog = std::make_unique<dag::MerkleLog>(m_storage->getInterface());
+  m_tips = m_dag->getTips();
+  m_dagWorker = std::make_unique<dag::DagWorker>(m_face.getIoContext(), *m_dag, m_config.policyThreshold,
+    [this] (const dag::DagWorker::Result& result) {
+      m_inFlight.erase(result.stateName);
+      m_tips = result.tips;
+      dagHarvest(result.interlocked);
+    },
+    m_config.dagWorkerThread, m_config.dagQueueCapacity);
+  m_tipSelector = dag::tip::TipSelector::createTipSelector(m_config.tipSelectorType, m_config.maxFanOut);
+  if (m_tipSelector == nullptr) {
+    NDN_THROW(std::runtime_error("Unknown tip selector " + m_config.tipSelectorType));
   }
 
+  // the global edge state list, or the pages of an existing one
+  m_statesTracker = std::make_unique<dag::StateTracker>(m_storage->getInterface(), m_interner);
+  scheduleTrackerFlush();
+  m_statusIndex = std::make_unique<dag::StatusIndex>(m_interner);
+  m_responseCache = std::make_unique<ResponseCache>(m_config.responseCacheSize);
+  m_nackCache = std::make_unique<NackCache>(m_config.nackCacheSize, m_config.freshnessPeriod);
+  m_certFilter = std::make_unique<util::BloomFilter>(m_config.certFilterCapacity);
+  loadIndexes();
+
   // initialize sync module
   Name syncPrefix = Name(m_config.ledgerPrefix).append("LEDGER").append("SYNC");
   m_syncOps.prefix = syncPrefix;
@@ -71,31 +109,80 @@ LedgerModule::LedgerModule(ndn::Face& face, ndn::KeyChain& keyChain, const std::
       // refresh the timer anyway
       refreshReplyTimer();
 
-      auto stateName = m_dag->add(record);
-      updateStatesTracker(stateName);
-      if (record.getType() != tlv::REPLY_RECORD) {
-        auto dataBlock = Block(record.getPayload());
-        Data data(dataBlock);
-        // put raw data into storage
-        try {
-          m_storage->addBlock(data.getName(), dataBlock);
-        }
-        catch (const std::runtime_error& e) {
-          NDN_LOG_DEBUG("Duplicate Data " << data.getName());
-          return;
-        }
-        try {
-          addPayloadMap(record.getPayload(), stateName);
-        }
-        catch (const std::runtime_error& e) {
-          NDN_LOG_TRACE("Adding PayloadMap failed because of: " << e.what());
-        }
+      // records of a catch-up arrive back to back, their payloads are hashed together
+      m_ingestQueue.push_back(record);
+      if (!m_ingestEvent) {
+        m_ingestEvent = m_scheduler.schedule(time::milliseconds(0), [this] {
+          m_ingestEvent = {};
+          ingestRecords();
+        });
       }
-      dagHarvest();
     }
   );
 }
 
+LedgerModule::~LedgerModule()
+{
+  // the worker ingests what it was given before it stops, and the records interlocked
+  // meanwhile are harvested as usual: Merkle leaves, index proofs, status; then the
+  // indexes are saved for the next start to read instead of every EdgeState
+  m_dagWorker->drain();
+  saveIndexes();
+}
+
+void
+LedgerModule::ingestRecords()
+{
+  auto records = std::move(m_ingestQueue);
+  m_ingestQueue.clear();
+
+  std::vector<span<const uint8_t>> payloads;
+  for (const auto& record : records) {
+    if (carriesCertificate(record)) {
+      payloads.push_back(record.getPayload());
+    }
+  }
+  // the implicit digests of the payload Data, in one pass
+  auto digests = util::sha256::hashMany(payloads);
+
+  auto digest = digests.begin();
+  for (const auto& record : records) {
+    auto stateName = dag::toStateName(record.getName());
+    updateStatesTracker(stateName);
+    if (record.getType() == tlv::CHECKPOINT_RECORD) {
+      try {
+        m_storage->addBlock(Data(Block(record.getPayload())).getName(), Block(record.getPayload()));
+      }
+      catch (const std::exception& e) {
+        NDN_LOG_DEBUG("Checkpoint of " << record.getName() << " not stored: " << e.what());
+      }
+    }
+    // indexed before the DAG may harvest it
+    else if (carriesCertificate(record)) {
+      auto implicitDigest = Name::Component::fromImplicitSha256Digest(*digest++);
+      auto dataBlock = Block(record.getPayload());
+      Data data(dataBlock);
+      // put raw data into storage
+      try {
+        m_storage->addBlock(data.getName(), dataBlock);
+      }
+      catch (const std::runtime_error& e) {
+        // also stored before a crash, with or without what follows
+        NDN_LOG_DEBUG("Duplicate Data " << data.getName());
+      }
+      try {
+        addPayloadMap(implicitDigest, stateName);
+      }
+      catch (const std::runtime_error& e) {
+        NDN_LOG_TRACE("Adding PayloadMap failed because of: " << e.what());
+      }
+      // keeps an existing entry, but adds to the filter either way
+      putCertIndex(data.getName(), implicitDigest, stateName);
+    }
+    submitRecord(record);
+  }
+}
+
 void
 LedgerModule::registerPrefix()
 {
@@ -111,6 +198,8 @@ LedgerModule::registerPrefix()
         NDN_LOG_TRACE("Registering filter for recordZone " << z);
         m_handle.handleFilter(filterId);
       }
+      auto filterId = m_face.setInterestFilter(m_batchPrefix, [this] (auto&&, const auto& i) { onBatchQuery(i); });
+      m_handle.handleFilter(filterId);
     },
     [this] (auto&&, const auto& reason) { onRegisterFailed(reason); }
   );
@@ -129,10 +218,13 @@ LedgerModule::registerPrefix()
     [this] (auto&&, const auto& reason) { onRegisterFailed(reason); }
   );
 
-  auto handleInternalObject = [this] (std::string className) {
+  auto handleInternalObject = [this] (std::string className, std::function<Block(const Name&)> getter) {
     auto prefixId = m_face.setInterestFilter(
     Name(m_instancePrefix).appendKeyword("internal").append(Name(className)),
-    [this] (auto&&, auto& i) {
+    [this, getter] (auto&&, auto& i) {
+      if (m_segmentServer->serve(i)) {
+        return;
+      }
       auto interestName = i.getName();
       if (i.getCanBePrefix() &&
           interestName.get(m_instancePrefix.size()) == 
@@ -141,7 +233,7 @@ LedgerModule::registerPrefix()
         auto objName = interestName.getSubName(m_instancePrefix.size() + 1);
         NDN_LOG_TRACE("An Internal Object Query for " << objName);
         try {
-          auto block = m_storage->getBlock(objName);
+          auto block = getter(objName);
           sendResponse(interestName, block, true);
         }
         catch (const std::runtime_error&) {
@@ -152,8 +244,14 @@ LedgerModule::registerPrefix()
     [this] (auto&&, const auto& reason) { onRegisterFailed(reason); });
     m_handle.handlePrefix(prefixId);
   };
-  handleInternalObject(dag::stateListNameHeader);
-  handleInternalObject(dag::stateNameHeader);
+  auto fromStorage = [this] (const Name& objName) { return m_storage->getBlock(objName); };
+  // the tracker pages in storage may lag behind, memory is authoritative
+  handleInternalObject(dag::stateListNameHeader,
+                       [this] (const Name& objName) { return m_statesTracker->getPage(objName); });
+  handleInternalObject(dag::stateNameHeader, fromStorage);
+  handleInternalObject(dag::checkpointNameHeader, fromStorage);
+  handleInternalObject(dag::statusNameHeader,
+                       [this] (const Name&) { return dag::encodeLedgerStatus(m_statusIndex->getStatus()); });
 }
 
 AppendStatus
@@ -185,6 +283,11 @@ LedgerModule::onQuery(const Interest& query)
 {
   // need to validate query format
   auto interestName = query.getName();
+  // segments of a response in session, with or without the hint of the query;
+  // those of a batch response are served by onBatchQuery(), whose filter matches too
+  if (!m_batchPrefix.isPrefixOf(interestName) && m_segmentServer->serve(query)) {
+    return;
+  }
   if (query.getForwardingHint().empty()) {
     return;
   }
@@ -195,42 +298,50 @@ LedgerModule::onQuery(const Interest& query)
     replyOrSendNack(interestName);
   }
   // query of a certificate or record
-  else if (Certificate::isValidName(interestName.set(-4, Name::Component("KEY"))))
+  else if (Certificate::isValidName(interestName.set(-4, Name::Component("KEY"))) &&
+           query.getName().get(-4) == Name::Component("PROOF"))
+  {
+    // proof mode: an audit path to the signed root instead of descendant records
+    NDN_LOG_TRACE("A Proof Query for " << interestName);
+    if (!mayKnowCert(interestName)) {
+      sendNack(query.getName());
+      return;
+    }
+    try {
+      auto content = makeProofContent(interestName);
+      if (!content) {
+        sendNack(query.getName());
+        return;
+      }
+      sendResponse(query.getName(), *content);
+    }
+    catch (const std::exception& e) {
+      NDN_LOG_DEBUG("Query Processing failed because of: " << e.what());
+      sendNack(query.getName());
+    }
+  }
+  // the condition above already put KEY back into interestName
+  else if (Certificate::isValidName(interestName))
   {
     NDN_LOG_TRACE("A Record Query for " << interestName.set(-4, Name::Component("KEY")));
-    // 1. get the cert data (payload) with cert name
-    // 2. map cert data to edge state name
+    if (auto cached = m_responseCache->find(query.getName())) {
+      NDN_LOG_TRACE("Ledger replies from the response cache");
+      m_segmentServer->publish(cached);
+      m_face.put(cached->getSegment(0));
+      return;
+    }
+    if (!mayKnowCert(interestName)) {
+      sendNack(query.getName());
+      return;
+    }
+    // the certificate index maps the cert name to its edge state and proof
     try {
-      Block content(ndn::tlv::Content);
-      auto payloadblock = m_storage->getBlock(interestName.set(-4, Name::Component("KEY")));
-      auto mapName = dag::toMapName(make_span<const uint8_t>(payloadblock.data(), payloadblock.size()));
-
-      NDN_LOG_TRACE("Finding PayloadMap... " << mapName);
-      auto mapblock = m_storage->getBlock(mapName);
-      auto payloadMap = dag::decodePayloadMap(mapblock);
-
-      NDN_LOG_TRACE("Finding EdgeState... " << payloadMap.mapTo);
-      auto stateblock = m_storage->getBlock(payloadMap.mapTo);
-      auto state = dag::decodeEdgeState(stateblock);
-      auto encoder = [this] (Block& b, const Name& n) {
-        auto tlv = m_storage->getBlock(n);
-        b.push_back(tlv);
-      };
-
-      // the queried record
-      NDN_LOG_TRACE("Finding Record... " << dag::fromStateName(state.stateName));
-      encoder(content, dag::fromStateName(state.stateName));
-      
-      // the descendants record
-      ssize_t count = 0;
-      for (auto& des : m_policy->select(state)) {
-        if (count++ < m_config.policyThreshold) {
-          NDN_LOG_TRACE("Finding Descendant Record... " << dag::fromStateName(des));
-          encoder(content, dag::fromStateName(des));
-        }
+      auto entry = getCertIndex(interestName);
+      auto response = sendResponse(query.getName(), makeRecordContent(entry));
+      // the proof of an interlocked record is final, until dagHarvest rewrites it
+      if (!entry.proof.empty()) {
+        m_responseCache->insert(query.getName(), m_interner->intern(entry.stateName), response);
       }
-      content.encode();
-      sendResponse(query.getName(), content);
     }
     catch (const std::exception& e) {
       NDN_LOG_DEBUG("Query Processing failed because of: " << e.what());
@@ -239,9 +350,7 @@ LedgerModule::onQuery(const Interest& query)
   }
   else {
     try {
-      Data data(m_storage->getBlock(query.getName()));
-      NDN_LOG_TRACE("Ledger replies with: " << data.getName());
-      m_face.put(data);
+      putStoredData(query.getName());
     }
     catch (std::exception& e) {
       NDN_LOG_DEBUG("Ledger storage cannot get the Data for reason: " << e.what());
@@ -251,23 +360,118 @@ LedgerModule::onQuery(const Interest& query)
   }
 }
 
+void
+LedgerModule::onBatchQuery(const Interest& query)
+{
+  // the batch prefix is registered, no forwarding hint on the query nor its segments
+  if (m_segmentServer->serve(query)) {
+    return;
+  }
+  if (!query.hasApplicationParameters()) {
+    return;
+  }
+
+  NDN_LOG_DEBUG("Received Batch Query " << query);
+  BatchQuery batch;
+  try {
+    batch = decodeBatchQuery(query.getApplicationParameters().blockFromValue());
+  }
+  catch (const std::exception& e) {
+    NDN_LOG_DEBUG("Batch Query Processing failed because of: " << e.what());
+    sendNack(query.getName());
+    return;
+  }
+
+  std::vector<BatchAnswer> answers;
+  for (const auto& certName : batch.certNames) {
+    BatchAnswer answer;
+    answer.certName = certName;
+    if (mayKnowCert(certName)) {
+      try {
+        if (batch.withProof) {
+          answer.content = makeProofContent(certName);
+        }
+        else {
+          answer.content = makeRecordContent(getCertIndex(certName));
+        }
+      }
+      catch (const std::exception& e) {
+        NDN_LOG_DEBUG("Batch Query of " << certName << " failed because of: " << e.what());
+      }
+    }
+    answers.push_back(std::move(answer));
+  }
+  // one segmented response, signed once for the whole batch
+  sendResponse(query.getName(), encodeBatchResponse(answers));
+}
+
+Block
+LedgerModule::makeRecordContent(const dag::CertIndexEntry& entry)
+{
+  // the stored wires, copied once into the response by encodeWires()
+  std::vector<Block> records;
+
+  // the queried record
+  NDN_LOG_TRACE("Finding Record... " << dag::fromStateName(entry.stateName));
+  records.push_back(m_storage->getBlock(dag::fromStateName(entry.stateName)));
+
+  // the descendants record
+  auto proof = entry.proof;
+  if (proof.empty()) {
+    // not interlocked yet, the descendants so far
+    NDN_LOG_TRACE("Finding EdgeState... " << entry.stateName);
+    auto stateblock = m_storage->getBlock(entry.stateName);
+    proof = selectProof(dag::decodeEdgeState(stateblock));
+  }
+  for (auto& des : proof) {
+    NDN_LOG_TRACE("Finding Descendant Record... " << dag::fromStateName(des));
+    records.push_back(m_storage->getBlock(dag::fromStateName(des)));
+  }
+  return util::encodeWires(ndn::tlv::Content, records);
+}
+
+optional<Block>
+LedgerModule::makeProofContent(const Name& certName)
+{
+  auto entry = getCertIndex(certName);
+  auto leafIndex = m_merkleLog->find(Name(entry.certName).append(entry.digest).wireEncode());
+  if (!leafIndex) {
+    NDN_LOG_DEBUG(certName << " is not interlocked yet");
+    return nullopt;
+  }
+  InclusionProof proof;
+  proof.leafIndex = *leafIndex;
+  proof.treeSize = m_merkleLog->size();
+  proof.path = m_merkleLog->prove(proof.leafIndex);
+
+  const Block elements[] = {getTreeHead().wireEncode(), encodeInclusionProof(proof)};
+  return util::encodeWires(ndn::tlv::Content, elements);
+}
+
 // there may exist some race conditions, but in most cases they won't happen
 void
 LedgerModule::publishReply()
 {
   NDN_LOG_TRACE("Attempting to generate reply record...");
 
+  m_dagWorker->post([threshold = m_config.policyThreshold] (dag::DagModule& dag) {
+                      return dag.harvestBelow(threshold);
+                    },
+                    [this] (std::list<Record> nonInterlocked) { publishReply(nonInterlocked); });
+}
+
+void
+LedgerModule::publishReply(const std::list<Record>& nonInterlocked)
+{
   Record newReply;
   newReply.setType(tlv::REPLY_RECORD);
 
-  auto nonInterlocked = m_dag->harvestBelow(m_config.policyThreshold);
   // two conditions: 1/ not a reply record; 2/ I haven't directly replied before
   for (auto& record : nonInterlocked) {
-    if (m_repliedRecords.find(record.getName()) == m_repliedRecords.end() &&
-        record.getType() != tlv::REPLY_RECORD) {
+    if (record.getType() != tlv::REPLY_RECORD &&
+        m_repliedRecords.insert(m_interner->intern(dag::toStateName(record.getName()))).second) {
       NDN_LOG_TRACE("Catching " << record.getName() << " for reply");
       newReply.addPointer(record.getName());
-      m_repliedRecords.insert(record.getName());
     }
   }
 
@@ -277,8 +481,7 @@ LedgerModule::publishReply()
     newReply.setName(newReplyName);
     // add to DAG
     NDN_LOG_INFO("Generating new [Reply] Record " << newReply.getName());
-    m_dag->add(newReply);
-    dagHarvest();
+    submitRecord(newReply);
   }
 }
 
@@ -298,21 +501,19 @@ LedgerModule::afterValidation(const Data& data)
   }
   catch (const std::runtime_error& e) {
     NDN_LOG_DEBUG("Duplicate Data " << data.getName());
+    // the filter is not stored, it may have been rebuilt without this one
+    m_certFilter->insert(data.getName());
     return;
   }
 
   // it is either a certificate or revocation record
   Record newRecord;
-  std::list<Name> pointers;
   // name is given by SVS, don't set it
 
   auto dataTlv = data.wireEncode();
   newRecord.setPayload(make_span<const uint8_t>(dataTlv.data(), dataTlv.size()));
-  for (auto& i : m_dag->getWaitList(0)) {
-    NDN_LOG_DEBUG("Referencing to [Generic] " << dag::fromStateName(i));
-    pointers.push_back(dag::fromStateName(i));
-  }
-  
+  auto pointers = selectPointers();
+  // records in flight are tips too, so this only happens on an empty ledger
   if (pointers.size() < 1) {
     // no waitlist, make a gensis record only referencing to itself
     newRecord.setType(tlv::GENESIS_RECORD);
@@ -332,33 +533,113 @@ LedgerModule::afterValidation(const Data& data)
   newRecord.setName(name);
   // add to DAG
   NDN_LOG_INFO("Generating new Record " << newRecord.getName());
-  addPayloadMap(newRecord.getPayload(), m_dag->add(newRecord));
+  // hashed once, shared by the PayloadMap and the index
+  auto implicitDigest = data.getFullName().get(-1);
+  addPayloadMap(implicitDigest, dag::toStateName(name));
+  putCertIndex(data.getName(), implicitDigest, dag::toStateName(name));
 
   // add to global edge state list
   updateStatesTracker(dag::toStateName(name));
-  dagHarvest();
+  submitRecord(newRecord);
 }
 
 void
-LedgerModule::addPayloadMap(const span<const uint8_t>& payload, const Name& mapTo)
+LedgerModule::addPayloadMap(const Name::Component& implicitDigest, const Name& mapTo)
 {
   dag::PayloadMap map;
-  map.mapName = dag::toMapName(payload);
+  map.mapName = dag::toMapName(implicitDigest);
   map.mapTo = mapTo;
   m_storage->addBlock(map.mapName, dag::encodePayloadMap(map));
 }
 
 Name
-LedgerModule::getPayloadMap(const span<const uint8_t>& payload)
+LedgerModule::getPayloadMap(const Name::Component& implicitDigest)
 {
   dag::PayloadMap map;
-  auto block = m_storage->getBlock(dag::toMapName(payload));
+  auto block = m_storage->getBlock(dag::toMapName(implicitDigest));
   return dag::decodePayloadMap(block).mapTo;
 }
 
+void
+LedgerModule::putCertIndex(const Name& certName, const Name::Component& implicitDigest, const Name& stateName)
+{
+  dag::CertIndexEntry entry;
+  entry.certName = certName;
+  entry.digest = implicitDigest;
+  entry.stateName = stateName;
+  putCertIndex(entry);
+}
+
+void
+LedgerModule::putCertIndex(const dag::CertIndexEntry& entry)
+{
+  m_certFilter->insert(entry.certName);
+  forgetNacks(entry.certName);
+  auto indexName = dag::toCertIndexName(entry.certName);
+  try {
+    m_storage->addBlock(indexName, dag::encodeCertIndexEntry(entry));
+  }
+  catch (const std::runtime_error&) {
+    // an entry without proof never replaces one, the record may be harvested before it is indexed
+    if (entry.proof.empty()) {
+      return;
+    }
+    m_storage->replaceBlock(indexName, dag::encodeCertIndexEntry(entry));
+  }
+}
+
+dag::CertIndexEntry
+LedgerModule::getCertIndex(const Name& certName)
+{
+  try {
+    return dag::decodeCertIndexEntry(m_storage->getBlock(dag::toCertIndexName(certName)));
+  }
+  catch (const std::runtime_error&) {
+    // ingested before the index existed: certificate, then its PayloadMap
+    NDN_LOG_TRACE("No index entry for " << certName << ", finding PayloadMap...");
+  }
+  dag::CertIndexEntry entry;
+  entry.certName = certName;
+  entry.digest = Data(m_storage->getBlock(certName)).getFullName().get(-1);
+  entry.stateName = getPayloadMap(entry.digest);
+  return entry;
+}
+
+bool
+LedgerModule::mayKnowCert(const Name& certName) const
+{
+  return !m_isCertFilterComplete || m_certFilter->mayContain(certName);
+}
+
+void
+LedgerModule::forgetNacks(const Name& certName)
+{
+  m_nackCache->erase(certName);
+  m_nackCache->erase(Name(certName).set(-4, Name::Component("RECORD")));
+  m_nackCache->erase(Name(certName).set(-4, Name::Component("PROOF")));
+}
+
+std::vector<Name>
+LedgerModule::selectProof(const dag::EdgeState& state)
+{
+  std::vector<Name> proof;
+  for (auto& des : m_policy->select(state)) {
+    if (proof.size() >= m_config.policyThreshold) {
+      break;
+    }
+    proof.push_back(des);
+  }
+  return proof;
+}
+
 void
 LedgerModule::sendNack(const Name& name)
 {
+  if (auto cached = m_nackCache->find(name)) {
+    NDN_LOG_TRACE("Ledger replies with cached: " << cached->getName());
+    m_face.put(*cached);
+    return;
+  }
   // reply with app layer nack
   Nack nack;
   auto data = nack.prepareData(name, time::toUnixTimestamp(time::system_clock::now()));
@@ -366,6 +647,7 @@ LedgerModule::sendNack(const Name& name)
   m_keyChain.sign(*data, signingByIdentity(m_instancePrefix));
   NDN_LOG_TRACE("Ledger replies with: " << data->getName());
   m_face.put(*data);
+  m_nackCache->insert(name, data);
 }
 
 void
@@ -373,9 +655,7 @@ LedgerModule::replyOrSendNack(const Name& name)
 {
   NDN_LOG_TRACE("Reply or Nack... " << name);
   try {
-    Data data(m_storage->getBlock(name));
-    NDN_LOG_TRACE("Ledger replies with: " << data.getName());
-    m_face.put(data);
+    putStoredData(name);
   }
   catch (std::exception& e) {
     sendNack(name);
@@ -383,72 +663,353 @@ LedgerModule::replyOrSendNack(const Name& name)
 }
 
 void
-LedgerModule::dagHarvest()
+LedgerModule::putStoredData(const Name& name)
 {
-  // harvest record that collects enough citations (e.g., 3)
+  auto wire = m_storage->getBlock(name);
+  // other objects share the storage, but only Data are served
+  if (wire.type() != ndn::tlv::Data) {
+    NDN_THROW(std::runtime_error(name.toUri() + " is not a stored Data"));
+  }
+  NDN_LOG_TRACE("Ledger replies with: " << name);
+  // the decoded Data keeps the stored wire, which Face::put() sends without encoding
+  // it again, after its packet size check and in order with the other packets
+  m_face.put(Data(wire));
+}
+
+void
+LedgerModule::dagHarvest(const std::list<Record>& recordList)
+{
+  // the DAG worker harvests records that collect enough citations (e.g., 3)
   // this ensures the waitlist be relatively small
-  auto recordList = m_dag->harvestAbove(m_config.policyThreshold, true);
-  // put those record into 
   if (recordList.size() > 0) {
     NDN_LOG_INFO("The following Records have been interlocked");
     for (auto& r : recordList) {
       NDN_LOG_INFO("   " << r.getName());
+      auto stateName = dag::toStateName(r.getName());
       // if applicable, remove from the replied set
-      if (m_repliedRecords.find(r.getName()) != m_repliedRecords.end()) {
-        m_repliedRecords.erase(r.getName());
+      auto id = m_interner->find(stateName);
+      if (id) {
+        m_repliedRecords.erase(*id);
+      }
+      updateStatesTracker(stateName, true);
+      // only certificates get a Merkle leaf and a proof
+      if (carriesCertificate(r)) {
+        Data data(Block(r.getPayload()));
+        dag::CertIndexEntry entry;
+        try {
+          // with the digest computed at ingest
+          entry = getCertIndex(data.getName());
+        }
+        catch (const std::exception&) {
+          entry.certName = data.getName();
+          entry.digest = data.getFullName().get(-1);
+          entry.stateName = stateName;
+        }
+        m_merkleLog->append(Name(entry.certName).append(entry.digest).wireEncode());
+        // the proof is final once interlocked, queries then skip the EdgeState;
+        // the same Data in another record keeps its first index entry
+        if (entry.stateName == stateName) {
+          try {
+            auto stateblock = m_storage->getBlock(stateName);
+            entry.proof = selectProof(dag::decodeEdgeState(stateblock));
+            putCertIndex(entry);
+            m_responseCache->invalidate(m_interner->intern(stateName));
+          }
+          catch (const std::runtime_error& e) {
+            NDN_LOG_DEBUG("Indexing " << data.getName() << " failed because of: " << e.what());
+          }
+        }
       }
-      updateStatesTracker(dag::toStateName(r.getName()), true);
     }
   }
+  if (m_config.epochSize > 0) {
+    publishCheckpoint();
+  }
 }
 
 void
-LedgerModule::updateStatesTracker(const Name& stateName, bool interlocked)
+LedgerModule::publishCheckpoint()
+{
+  m_dagWorker->post([epochSize = m_config.epochSize, threshold = m_config.policyThreshold]
+                    (dag::DagModule& dag) -> optional<dag::EpochCheckpoint> {
+                      if (dag.getEpochSize() < epochSize) {
+                        return nullopt;
+                      }
+                      return dag.checkpoint(threshold);
+                    },
+                    [this] (optional<dag::EpochCheckpoint> checkpoint) {
+                      if (checkpoint) {
+                        publishCheckpoint(*checkpoint);
+                      }
+                    });
+}
+
+void
+LedgerModule::publishCheckpoint(const dag::EpochCheckpoint& checkpoint)
+{
+  // the published commitment leaves the record list in the local checkpoint object
+  auto summary = checkpoint;
+  summary.records.clear();
+  Data data(Name(m_instancePrefix).append("CHECKPOINT").appendNumber(checkpoint.epoch));
+  data.setContent(dag::encodeEpochCheckpoint(summary));
+  m_keyChain.sign(data, signingByIdentity(m_instancePrefix));
+  auto dataTlv = data.wireEncode();
+  m_storage->addBlock(data.getName(), dataTlv);
+
+  Record newRecord;
+  newRecord.setType(tlv::CHECKPOINT_RECORD);
+  newRecord.setPayload(make_span<const uint8_t>(dataTlv.data(), dataTlv.size()));
+  auto pointers = selectPointers();
+  if (pointers.empty()) {
+    pointers.push_back(checkpoint.records.back());
+  }
+  newRecord.setPointers(pointers);
+
+  Name name = m_sync->publishRecord(newRecord);
+  newRecord.setName(name);
+  NDN_LOG_INFO("Generating new [Checkpoint] Record " << name << " for epoch " << checkpoint.epoch
+               << " of " << checkpoint.size << " records");
+  // not a certificate: no PayloadMap, index entry nor Merkle leaf
+  updateStatesTracker(dag::toStateName(name));
+  submitRecord(newRecord);
+}
+
+const Data&
+LedgerModule::getTreeHead()
 {
-  Name trackerName = dag::toStateListName(dag::globalTracker);
-  auto trackerBlock = m_storage->getBlock(trackerName);
-  dag::EdgeStateList statesTracker = dag::decodeEdgeStateList(trackerBlock);
+  // named after the tree size
+  if (m_treeHead && m_treeHead->getName().get(-1).toNumber() == m_merkleLog->size()) {
+    return *m_treeHead;
+  }
+  TreeHead treeHead;
+  treeHead.treeSize = m_merkleLog->size();
+  treeHead.root = m_merkleLog->root();
+  Data data(Name(m_instancePrefix).append("TREE-HEAD").appendNumber(treeHead.treeSize));
+  data.setContent(encodeTreeHead(treeHead));
+  data.setFreshnessPeriod(m_config.freshnessPeriod);
+  m_keyChain.sign(data, signingByIdentity(m_instancePrefix));
+  m_treeHead = data;
+  return *m_treeHead;
+}
 
-  if (statesTracker.value.find(stateName) == statesTracker.value.end()) {
-    statesTracker.value.insert(stateName);
+std::list<Name>
+LedgerModule::selectPointers()
+{
+  // the tips the worker last reported, and the records it has not reported yet;
+  // whatever the latter point to is no longer a tip
+  std::set<Name> covered;
+  for (auto& p : m_inFlight) {
+    for (auto& ptr : p.second.record.getPointers()) {
+      covered.insert(dag::toStateName(ptr));
+    }
   }
-  else if (interlocked) {
-    auto stateBlock = m_storage->getBlock(stateName);
-    dag::EdgeState state = dag::decodeEdgeState(stateBlock);
-    state.interlocked = time::system_clock::now();
-    m_storage->deleteBlock(stateName);
-    m_storage->addBlock(stateName, dag::encodeEdgeState(state));
+  std::vector<dag::EdgeState> tips;
+  for (auto& tip : m_tips) {
+    if (covered.count(tip.stateName) == 0 && m_inFlight.count(tip.stateName) == 0) {
+      tips.push_back(tip);
+    }
   }
-  else {
+  for (auto& p : m_inFlight) {
+    if (covered.count(p.first) == 0) {
+      tips.push_back(p.second);
+    }
+  }
+
+  std::list<Name> pointers;
+  for (auto& i : m_tipSelector->select(tips, m_sync->getNextName().getPrefix(-1))) {
+    NDN_LOG_DEBUG("Referencing to [Generic] " << i);
+    pointers.push_back(i);
+  }
+  return pointers;
+}
+
+void
+LedgerModule::submitRecord(const Record& record)
+{
+  // a tip for selectPointers() until the worker reports it ingested
+  dag::EdgeState state;
+  state.stateName = dag::toStateName(record.getName());
+  state.record = record;
+  state.status = dag::EdgeState::LOADED;
+  state.created = time::system_clock::now();
+  m_inFlight.insert_or_assign(state.stateName, std::move(state));
+  m_dagWorker->submit(record);
+}
+
+void
+LedgerModule::updateStatesTracker(const Name& stateName, bool interlocked)
+{
+  // already tracked when interlocked: the interlock time is stamped by DagModule::harvestAbove
+  bool isNew = m_statesTracker->add(stateName);
+  if (!isNew && !interlocked) {
     NDN_LOG_WARN("Tracker refused to update a non-interlocked EdgeState, ignore this if in failure recovery...");
-    return;
   }
-  m_storage->deleteBlock(trackerName);
-  m_storage->addBlock(trackerName, dag::encodeEdgeStateList(statesTracker));
+  if (interlocked) {
+    m_statusIndex->markInterlocked(stateName, time::system_clock::now());
+  }
+  // a tracked record is indexed already, maybe only counted if restored from a snapshot
+  else if (isNew) {
+    m_statusIndex->addPending(stateName, time::system_clock::now());
+  }
+  // states added within the same io turn go to the journal as one batch
+  if (m_statesTracker->hasUncommitted() && !m_trackerCommitEvent) {
+    m_trackerCommitEvent = m_scheduler.schedule(time::milliseconds(0), [this] {
+      m_trackerCommitEvent = {};
+      m_statesTracker->commit();
+    });
+  }
+}
+
+bool
+LedgerModule::loadSnapshot(const Name& name, const std::function<void(const Block&)>& load)
+{
+  Block block;
+  try {
+    block = m_storage->getBlock(name);
+    // a crash from now on leaves no stale snapshot behind
+    m_storage->deleteBlock(name);
+  }
+  catch (const std::runtime_error&) {
+    return false;
+  }
+  try {
+    load(block);
+    return true;
+  }
+  catch (const std::exception& e) {
+    NDN_LOG_WARN("Ignoring snapshot " << name << ": " << e.what());
+    return false;
+  }
+}
+
+void
+LedgerModule::loadIndexes()
+{
+  bool hasStatus = loadSnapshot(dag::statusSnapshotName,
+                                [this] (const Block& block) { m_statusIndex->loadSnapshot(block); });
+  bool hasFilter = loadSnapshot(dag::certFilterName,
+                                [this] (const Block& block) { m_certFilter->restore(block); });
+  if (hasStatus) {
+    // only a guard: the worker drains before the snapshot is taken
+    for (const auto& stateName : m_statusIndex->listPending()) {
+      try {
+        auto block = m_storage->getBlock(stateName);
+        auto state = dag::decodeEdgeState(block);
+        if (state.status == dag::EdgeState::INTERLOCKED || state.status == dag::EdgeState::CHECKPOINTED) {
+          m_statusIndex->markInterlocked(stateName, state.interlocked);
+        }
+      }
+      catch (const std::exception&) {
+        // not stored yet, still pending
+      }
+    }
+  }
+  if (!hasFilter) {
+    // index entries embed the certificate Name, only the keys are read
+    auto headerSize = Name(dag::certIndexNameHeader).size();
+    m_storage->forEachName(dag::certIndexNameHeader, [this, headerSize] (const Name& indexName) {
+      m_certFilter->insert(indexName.getSubName(headerSize));
+    });
+  }
+
+  if (!hasStatus || !hasFilter) {
+    // one local pass over the stored states, for what the snapshots did not cover
+    m_statesTracker->forEach([this, hasStatus, hasFilter] (const Name& stateName) {
+      optional<dag::EdgeState> state;
+      try {
+        auto block = m_storage->getBlock(stateName);
+        state = dag::decodeEdgeState(block);
+      }
+      catch (const std::exception&) {
+        // tracked but not stored yet, the DAG will ingest it again
+      }
+      if (!hasStatus) {
+        if (!state) {
+          m_statusIndex->addPending(stateName, time::system_clock::now());
+        }
+        else if (state->status == dag::EdgeState::INTERLOCKED || state->status == dag::EdgeState::CHECKPOINTED) {
+          m_statusIndex->markInterlocked(stateName, state->interlocked);
+        }
+        else {
+          m_statusIndex->addPending(stateName, state->created);
+        }
+      }
+      // records ingested before the index existed, or tracked before it was written
+      if (!hasFilter) {
+        try {
+          Record record;
+          if (state) {
+            record = state->record;
+          }
+          else {
+            Data recordData(m_storage->getBlock(dag::fromStateName(stateName)));
+            record = Record(recordData.getName(), Block(recordData.getContent().value_bytes()));
+          }
+          if (carriesCertificate(record)) {
+            m_certFilter->insert(Data(Block(record.getPayload())).getName());
+          }
+        }
+        catch (const std::exception& e) {
+          // a missing certificate would be nacked for good, so the filter is not used at all
+          if (m_isCertFilterComplete) {
+            NDN_LOG_WARN("Certificate filter disabled, cannot read " << stateName << ": " << e.what());
+          }
+          m_isCertFilterComplete = false;
+        }
+      }
+    });
+  }
+  NDN_LOG_DEBUG("Status index: " << m_statusIndex->getPendingCount() << " pending, "
+                << m_statusIndex->getInterlockedCount() << " interlocked");
 }
 
 void
+LedgerModule::saveIndexes()
+{
+  try {
+    // the snapshot only counts what the tracker lists
+    if (m_statesTracker->hasUncommitted()) {
+      m_statesTracker->commit();
+    }
+    m_storage->replaceBlock(dag::statusSnapshotName, m_statusIndex->encodeSnapshot());
+    // an incomplete filter is rebuilt instead
+    if (m_isCertFilterComplete) {
+      m_storage->replaceBlock(dag::certFilterName, m_certFilter->encode());
+    }
+  }
+  catch (const std::exception& e) {
+    NDN_LOG_WARN("Indexes not saved, they will be rebuilt at the next start: " << e.what());
+  }
+}
+
+void
+LedgerModule::scheduleTrackerFlush()
+{
+  m_scheduler.schedule(m_config.trackerFlushPeriod, [this] {
+    // also covers the states not committed yet
+    m_statesTracker->flush();
+    scheduleTrackerFlush();
+  });
+}
+
+std::shared_ptr<const util::segment::SegmentedObject>
 LedgerModule::sendResponse(const Name& name, const Block& block, bool realtime)
 {
   Name versionedName(name);
   versionedName.append("data").appendVersion();
 
-  util::segment::Producer::Options opts;
+  util::segment::SegmentedObject::Options opts;
   opts.maxSegmentSize = m_config.maxSegmentSize;
   opts.freshnessPeriod = m_config.freshnessPeriod;
   opts.signingInfo = signingByIdentity(m_instancePrefix);
+  opts.useManifest = m_config.segmentManifest;
 
-  auto producer = std::make_shared<util::segment::Producer>(
-    versionedName, m_face, m_keyChain, block, opts
-  );
-  auto data = producer->getDataStore()[0];
-  m_face.put(*data);
-
-  NDN_LOG_DEBUG("Ledger starts a session hosting segmented " << versionedName);
-  // I don't why but it works
-  m_scheduler.schedule(m_config.sessionLength, [versionedName, producer] {
-    NDN_LOG_DEBUG("Ledger stops a session hosting segmented " << versionedName);
-  });
+  // only the first segment is signed here, the others when first fetched through
+  // the filters already set in registerPrefix()
+  auto response = std::make_shared<util::segment::SegmentedObject>(versionedName, block, m_keyChain, opts);
+  m_segmentServer->publish(response);
+  m_face.put(response->getSegment(0));
+  return response;
 }
 
 void
@@ -3,18 +3,30 @@
 
 #include "ledger-config.hpp"
 #include "nack.hpp"
+#include "nack-cache.hpp"
+#include "response-cache.hpp"
 
 #include "append/handle.hpp"
 #include "append/ledger.hpp"
 
 #include "storage/ledger-storage.hpp"
 #include "sync/sync-module.hpp"
+#include "dag/cert-index.hpp"
 #include "dag/dag-module.hpp"
+#include "dag/dag-worker.hpp"
+#include "dag/interlock-engine.hpp"
+#include "dag/merkle-log.hpp"
+#include "dag/state-tracker.hpp"
+#include "dag/status-index.hpp"
+#include "dag/tip-selector.hpp"
+#include "util/bloom-filter.hpp"
 
 #include <ndn-cxx/face.hpp>
 #include <ndn-cxx/security/key-chain.hpp>
 #include <ndn-cxx/security/validator-config.hpp>
 
+#include <unordered_set>
+
 namespace cledger::ledger {
 using appendtlv::AppendStatus;
 
@@ -23,6 +35,8 @@ class LedgerModule : boost::noncopyable
 public:
   LedgerModule(ndn::Face& face, ndn::KeyChain& keyChain, const std::string& configPath, time::milliseconds replyPeriod = 3600_s);
 
+  ~LedgerModule();
+
   const std::unique_ptr<storage::LedgerStorage>&
   getLedgerStorage()
   {
@@ -38,9 +52,22 @@ public:
   void
   onQuery(const Interest& query);
 
+  /**
+   * @brief Answer the certificates listed in the ApplicationParameters of @p query
+   *        with one segmented response.
+   */
+  void
+  onBatchQuery(const Interest& query);
+
   void
   publishReply();
 
+  /**
+   * @brief Publish a reply record pointing to the records of @p nonInterlocked not replied yet.
+   */
+  void
+  publishReply(const std::list<Record>& nonInterlocked);
+
 CLEDGER_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
 
   AppendStatus onDataSubmission(const Data& data);
@@ -54,11 +81,66 @@ CLEDGER_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   onRegisterFailed(const std::string& reason);
 
+  /**
+   * @brief Store, index and submit the records the sync module yielded since the last batch.
+   */
+  void
+  ingestRecords();
+
+  /**
+   * @brief Map a payload Data, by its implicit digest, to its EdgeState.
+   */
   void
-  addPayloadMap(const span<const uint8_t>& payload, const Name& mapTo);
+  addPayloadMap(const Name::Component& implicitDigest, const Name& mapTo);
 
   Name
-  getPayloadMap(const span<const uint8_t>& payload);
+  getPayloadMap(const Name::Component& implicitDigest);
+
+  /**
+   * @brief Index a certificate under its Name, with no proof until it is interlocked.
+   */
+  void
+  putCertIndex(const Name& certName, const Name::Component& implicitDigest, const Name& stateName);
+
+  void
+  putCertIndex(const dag::CertIndexEntry& entry);
+
+  /**
+   * @brief The index entry of a certificate, or one rebuilt from its PayloadMap.
+   */
+  dag::CertIndexEntry
+  getCertIndex(const Name& certName);
+
+  /**
+   * @return false if @p certName is definitely not in the ledger, without a storage read
+   */
+  bool
+  mayKnowCert(const Name& certName) const;
+
+  /**
+   * @brief Drop the cached Nacks of a certificate and of the queries about it.
+   */
+  void
+  forgetNacks(const Name& certName);
+
+  /**
+   * @brief The record of a certificate and its descendants, as a record query returns them.
+   */
+  Block
+  makeRecordContent(const dag::CertIndexEntry& entry);
+
+  /**
+   * @brief The signed tree head and the audit path of a certificate, as a proof query
+   *        returns them; nullopt if the certificate is not interlocked yet.
+   */
+  optional<Block>
+  makeProofContent(const Name& certName);
+
+  /**
+   * @brief The descendants a record query returns, at most policyThreshold of them.
+   */
+  std::vector<Name>
+  selectProof(const dag::EdgeState& state);
 
   void
   sendNack(const Name& name);
@@ -66,11 +148,47 @@ CLEDGER_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   replyOrSendNack(const Name& name);
 
+  /**
+   * @brief Send the Data stored under @p name without encoding it again.
+   * @throw std::runtime_error the storage has no Data under @p name
+   */
   void
+  putStoredData(const Name& name);
+
+  /**
+   * @brief Put the first segment of @p block and serve the others for a session.
+   * @return the segments, served by m_segmentServer
+   */
+  std::shared_ptr<const util::segment::SegmentedObject>
   sendResponse(const Name& name, const Block& block, bool realtime = false);
 
   void
-  dagHarvest();
+  dagHarvest(const std::list<Record>& recordList);
+
+  /**
+   * @brief Close the epoch once enough records are interlocked, and publish
+   *        a checkpoint record carrying its signed Merkle root.
+   */
+  void
+  publishCheckpoint();
+
+  void
+  publishCheckpoint(const dag::EpochCheckpoint& checkpoint);
+
+  std::list<Name>
+  selectPointers();
+
+  /**
+   * @brief Hand @p record to the DAG worker, keeping it as a tip until it is ingested.
+   */
+  void
+  submitRecord(const Record& record);
+
+  /**
+   * @brief The Merkle log's size and root, signed; re-signed only once the log grew.
+   */
+  const Data&
+  getTreeHead();
 
   void
   updateStatesTracker(const Name& stateName, bool interlocked = false);
@@ -78,10 +196,32 @@ CLEDGER_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   refreshReplyTimer();
 
+  /**
+   * @brief Read and delete the snapshot stored under @p name, and give it to @p load.
+   * @return whether there was one and @p load took it
+   */
+  bool
+  loadSnapshot(const Name& name, const std::function<void(const Block&)>& load);
+
+  /**
+   * @brief Fill the status index and the certificate filter from the snapshots saved at
+   *        shutdown, or else from one pass over the tracked states.
+   */
+  void
+  loadIndexes();
+
+  void
+  saveIndexes();
+
+  void
+  scheduleTrackerFlush();
+
   ndn::Face& m_face;
   LedgerConfig m_config;
   Scheduler m_scheduler{m_face.getIoContext()};
   Name m_instancePrefix;
+  // batch queries, which a record zone may cover too
+  Name m_batchPrefix;
   ndn::KeyChain& m_keyChain;
   ndn::ValidatorConfig m_validator{m_face};
 
@@ -94,14 +234,43 @@ CLEDGER_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
 
   // sync module
   std::unique_ptr<sync::SyncModule> m_sync;
+  std::vector<Record> m_ingestQueue;
+  ndn::scheduler::EventId m_ingestEvent;
   sync::SyncOptions m_syncOps;
   sync::SecurityOptions m_secOps{m_keyChain};
 
   // dag module
   std::unique_ptr<dag::policy::InterlockPolicy> m_policy;
+  // scores the recent window in batch, when configured
+  std::unique_ptr<dag::policy::InterlockEngine> m_interlockEngine;
   std::unique_ptr<dag::DagModule> m_dag;
+  // all DAG ingestion goes through the worker
+  std::unique_ptr<dag::DagWorker> m_dagWorker;
+  // tips as of the last ingestion, and the records submitted since, by state name
+  std::vector<dag::EdgeState> m_tips;
+  std::map<Name, dag::EdgeState> m_inFlight;
+  std::unique_ptr<dag::tip::TipSelector> m_tipSelector;
+  // interlocked records, for proof-mode queries
+  std::unique_ptr<dag::MerkleLog> m_merkleLog;
+  optional<Data> m_treeHead;
+  // state Name IDs, shared with the DAG module
+  std::shared_ptr<dag::NameInterner> m_interner;
+  // every EdgeState, served to ndncledger-ledger-status
+  std::unique_ptr<dag::StateTracker> m_statesTracker;
+  ndn::scheduler::EventId m_trackerCommitEvent;
+  // pending and interlocked records, for status summaries
+  std::unique_ptr<dag::StatusIndex> m_statusIndex;
+  // segments of the responses in session, under the record zones and the instance prefix
+  std::unique_ptr<util::segment::SegmentServer> m_segmentServer;
+  // responses to record queries of interlocked records
+  std::unique_ptr<ResponseCache> m_responseCache;
+  // Nacks of unknown names, signed once per freshness period
+  std::unique_ptr<NackCache> m_nackCache;
+  // every certificate in the ledger, unless some could not be read back at startup
+  std::unique_ptr<util::BloomFilter> m_certFilter;
+  bool m_isCertFilterComplete = true;
   // this shouldn't keep growing, so it's safe to put into the memory
-  std::set<Name> m_repliedRecords;
+  std::unordered_set<dag::NameId> m_repliedRecords;
 
   // reply management
   time::milliseconds m_replyPeriod;
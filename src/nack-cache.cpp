@@ -0,0 +1,56 @@
+#include "nack-cache.hpp"
+
+namespace cledger::ledger {
+
+NackCache::NackCache(size_t capacity, time::milliseconds freshnessPeriod)
+  : m_capacity(capacity)
+  , m_freshnessPeriod(freshnessPeriod)
+{
+}
+
+std::shared_ptr<const Data>
+NackCache::find(const Name& name)
+{
+  auto it = m_byName.find(name);
+  if (it == m_byName.end()) {
+    return nullptr;
+  }
+  if (it->second->expiry <= time::steady_clock::now()) {
+    erase(it->second);
+    return nullptr;
+  }
+  m_entries.splice(m_entries.begin(), m_entries, it->second);
+  return it->second->nack;
+}
+
+void
+NackCache::insert(const Name& name, std::shared_ptr<const Data> nack)
+{
+  if (m_capacity == 0) {
+    return;
+  }
+  erase(name);
+  if (m_entries.size() >= m_capacity) {
+    erase(std::prev(m_entries.end()));
+  }
+  m_entries.push_front({name, std::move(nack), time::steady_clock::now() + m_freshnessPeriod});
+  m_byName.emplace(name, m_entries.begin());
+}
+
+void
+NackCache::erase(const Name& name)
+{
+  auto it = m_byName.find(name);
+  if (it != m_byName.end()) {
+    erase(it->second);
+  }
+}
+
+void
+NackCache::erase(std::list<Entry>::iterator it)
+{
+  m_byName.erase(it->name);
+  m_entries.erase(it);
+}
+
+} // namespace cledger::ledger
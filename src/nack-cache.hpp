@@ -0,0 +1,66 @@
+#ifndef CLEDGER_NACK_CACHE_HPP
+#define CLEDGER_NACK_CACHE_HPP
+
+#include "cledger-common.hpp"
+
+#include <list>
+#include <unordered_map>
+
+namespace cledger::ledger {
+
+/**
+ * @brief Least recently used cache of signed application Nacks, by the Name they deny.
+ *
+ * A Nack is handed out again until its freshness period is over, so a name is signed
+ * for at most once per freshness period, however often it is asked for.
+ */
+class NackCache
+{
+public:
+  /**
+   * @param capacity number of Nacks kept, 0 to disable the cache
+   */
+  NackCache(size_t capacity, time::milliseconds freshnessPeriod);
+
+  /**
+   * @return the still fresh Nack of @p name, or nullptr
+   */
+  std::shared_ptr<const Data>
+  find(const Name& name);
+
+  void
+  insert(const Name& name, std::shared_ptr<const Data> nack);
+
+  /**
+   * @brief Drop the Nack of @p name, e.g., once it exists.
+   */
+  void
+  erase(const Name& name);
+
+  size_t
+  size() const
+  {
+    return m_entries.size();
+  }
+
+private:
+  struct Entry
+  {
+    Name name;
+    std::shared_ptr<const Data> nack;
+    time::steady_clock::time_point expiry;
+  };
+
+  void
+  erase(std::list<Entry>::iterator it);
+
+  size_t m_capacity;
+  time::milliseconds m_freshnessPeriod;
+  // most recently used first
+  std::list<Entry> m_entries;
+  std::unordered_map<Name, std::list<Entry>::iterator> m_byName;
+};
+
+} // namespace cledger::ledger
+
+#endif // CLEDGER_NACK_CACHE_HPP
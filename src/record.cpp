@@ -8,10 +8,11 @@ Record::Record()
 }
 
 Record::Record(const Name& name, const Block& content)
+  : m_content(content)
 {
   m_name = name;
-  content.parse();
-  for (const auto &item : content.elements()) {
+  m_content.parse();
+  for (const auto &item : m_content.elements()) {
     switch (item.type()) {
       case tlv::TLV_RECORD_TYPE:
         m_type = readNonNegativeInteger(item);
@@ -70,6 +70,8 @@ private:
   RecordType m_type;
   std::list<Name> m_pointers;
   span<const uint8_t> m_payload;
+  // keeps the decoded wire alive, the payload points into it
+  Block m_content;
 };
 
 std::ostream&
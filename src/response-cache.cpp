@@ -0,0 +1,57 @@
+#include "response-cache.hpp"
+
+namespace cledger::ledger {
+
+ResponseCache::ResponseCache(size_t capacity)
+  : m_capacity(capacity)
+{
+}
+
+ResponseCache::ObjectPtr
+ResponseCache::find(const Name& queryName)
+{
+  auto it = m_byQuery.find(queryName);
+  if (it == m_byQuery.end()) {
+    return nullptr;
+  }
+  m_entries.splice(m_entries.begin(), m_entries, it->second);
+  return it->second->object;
+}
+
+void
+ResponseCache::insert(const Name& queryName, dag::NameId stateId, ObjectPtr object)
+{
+  if (m_capacity == 0) {
+    return;
+  }
+  auto byQuery = m_byQuery.find(queryName);
+  if (byQuery != m_byQuery.end()) {
+    erase(byQuery->second);
+  }
+  invalidate(stateId);
+  if (m_entries.size() >= m_capacity) {
+    erase(std::prev(m_entries.end()));
+  }
+  m_entries.push_front({queryName, stateId, std::move(object)});
+  m_byQuery.emplace(queryName, m_entries.begin());
+  m_byState.emplace(stateId, m_entries.begin());
+}
+
+void
+ResponseCache::invalidate(dag::NameId stateId)
+{
+  auto it = m_byState.find(stateId);
+  if (it != m_byState.end()) {
+    erase(it->second);
+  }
+}
+
+void
+ResponseCache::erase(std::list<Entry>::iterator it)
+{
+  m_byQuery.erase(it->queryName);
+  m_byState.erase(it->stateId);
+  m_entries.erase(it);
+}
+
+} // namespace cledger::ledger
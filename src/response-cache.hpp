@@ -0,0 +1,71 @@
+#ifndef CLEDGER_RESPONSE_CACHE_HPP
+#define CLEDGER_RESPONSE_CACHE_HPP
+
+#include "dag/name-interner.hpp"
+#include "util/segment/segment-server.hpp"
+
+#include <list>
+#include <unordered_map>
+
+namespace cledger::ledger {
+
+/**
+ * @brief Least recently used cache of segmented, signed query responses.
+ *
+ * Entries are found by query Name and dropped by the state they answer for, once that
+ * state's status or proof changes. A repeated query only publishes the cached segments
+ * again and puts the first one.
+ */
+class ResponseCache
+{
+public:
+  using ObjectPtr = std::shared_ptr<const util::segment::SegmentedObject>;
+
+  /**
+   * @param capacity number of responses kept, 0 to disable the cache
+   */
+  explicit
+  ResponseCache(size_t capacity);
+
+  /**
+   * @return the response to @p queryName, or nullptr
+   */
+  ObjectPtr
+  find(const Name& queryName);
+
+  void
+  insert(const Name& queryName, dag::NameId stateId, ObjectPtr object);
+
+  /**
+   * @brief Drop the response to the queries about @p stateId, if any.
+   */
+  void
+  invalidate(dag::NameId stateId);
+
+  size_t
+  size() const
+  {
+    return m_entries.size();
+  }
+
+private:
+  struct Entry
+  {
+    Name queryName;
+    dag::NameId stateId;
+    ObjectPtr object;
+  };
+
+  void
+  erase(std::list<Entry>::iterator it);
+
+  size_t m_capacity;
+  // most recently used first
+  std::list<Entry> m_entries;
+  std::unordered_map<Name, std::list<Entry>::iterator> m_byQuery;
+  std::unordered_map<dag::NameId, std::list<Entry>::iterator> m_byState;
+};
+
+} // namespace cledger::ledger
+
+#endif // CLEDGER_RESPONSE_CACHE_HPP
@@ -63,6 +63,34 @@ LedgerLevelDB::deleteBlock(const Name& name)
   }
 }
 
+void
+LedgerLevelDB::replaceBlock(const Name& name, const Block& block)
+{
+  // a Put overwrites the key in one write
+  std::string data_str = std::string(reinterpret_cast<const char*>(block.data()), block.size());
+  leveldb::Status status = m_db->Put(leveldb::WriteOptions(), name.toUri(), data_str);
+  if (!status.ok()){
+    NDN_THROW(std::runtime_error("DB cannot replace block: "+ name.toUri()));
+  }
+}
+
+void
+LedgerLevelDB::forEachName(const Name& prefix, const std::function<void(const Name&)>& visit)
+{
+  // keys are URIs, so the names under a prefix share its URI and a slash
+  std::string start = prefix.toUri();
+  if (start.back() != '/') {
+    start += '/';
+  }
+  std::unique_ptr<leveldb::Iterator> it(m_db->NewIterator(leveldb::ReadOptions()));
+  for (it->Seek(start); it->Valid() && it->key().starts_with(start); it->Next()) {
+    visit(Name(it->key().ToString()));
+  }
+  if (!it->status().ok()) {
+    NDN_THROW(std::runtime_error("DB cannot list the names under " + prefix.toUri()));
+  }
+}
+
 Interface
 LedgerLevelDB::getInterface()
 {
@@ -70,6 +98,7 @@ LedgerLevelDB::getInterface()
   intf.adder = std::bind(&LedgerLevelDB::addBlock, this, _1, _2);
   intf.getter = std::bind(&LedgerLevelDB::getBlock, this, _1);
   intf.deleter = std::bind(&LedgerLevelDB::deleteBlock, this, _1); 
+  intf.replacer = std::bind(&LedgerLevelDB::replaceBlock, this, _1, _2);
   return intf;
 }
 
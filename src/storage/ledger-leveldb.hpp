@@ -25,6 +25,12 @@ public:
   void
   deleteBlock(const Name& name) override;
 
+  void
+  replaceBlock(const Name& name, const Block& block) override;
+
+  void
+  forEachName(const Name& prefix, const std::function<void(const Name&)>& visit) override;
+
   Interface
   getInterface() override;
 
@@ -14,6 +14,7 @@ LedgerMemory::LedgerMemory(const Name& lederName, const std::string& path)
 void
 LedgerMemory::addBlock(const Name& name, const Block& block)
 {
+  std::lock_guard<std::mutex> lock(m_mutex);
   auto search = m_list.find(name);
   if (search != m_list.end()) {
     NDN_THROW(std::runtime_error("Block for " + name.toUri() + " already exists"));
@@ -24,6 +25,7 @@ LedgerMemory::addBlock(const Name& name, const Block& block)
 Block
 LedgerMemory::getBlock(const Name& name)
 {
+  std::lock_guard<std::mutex> lock(m_mutex);
   auto search = m_list.find(name);
   if (search == m_list.end()) {
     NDN_THROW(std::runtime_error("Block for " + name.toUri() + " does not exists"));
@@ -34,6 +36,7 @@ LedgerMemory::getBlock(const Name& name)
 void
 LedgerMemory::deleteBlock(const Name& name)
 {
+  std::lock_guard<std::mutex> lock(m_mutex);
   auto search = m_list.find(name);
   if (search == m_list.end()) {
     NDN_THROW(std::runtime_error("Block for " + name.toUri() + " does not exists"));
@@ -41,6 +44,30 @@ LedgerMemory::deleteBlock(const Name& name)
   m_list.erase(search);
 }
 
+void
+LedgerMemory::replaceBlock(const Name& name, const Block& block)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_list.insert_or_assign(name, block);
+}
+
+void
+LedgerMemory::forEachName(const Name& prefix, const std::function<void(const Name&)>& visit)
+{
+  std::vector<Name> names;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // the names under a prefix follow it in canonical order
+    for (auto it = m_list.upper_bound(prefix); it != m_list.end() && prefix.isPrefixOf(it->first); ++it) {
+      names.push_back(it->first);
+    }
+  }
+  // visited without the lock, the visitor may read the storage back
+  for (const auto& name : names) {
+    visit(name);
+  }
+}
+
 Interface
 LedgerMemory::getInterface()
 {
@@ -48,6 +75,7 @@ LedgerMemory::getInterface()
   intf.adder = std::bind(&LedgerMemory::addBlock, this, _1, _2);
   intf.getter = std::bind(&LedgerMemory::getBlock, this, _1);
   intf.deleter = std::bind(&LedgerMemory::deleteBlock, this, _1);
+  intf.replacer = std::bind(&LedgerMemory::replaceBlock, this, _1, _2);
   return intf;
 }
 
@@ -3,6 +3,8 @@
 
 #include "ledger-storage.hpp"
 
+#include <mutex>
+
 namespace cledger {
 namespace storage {
 
@@ -22,10 +24,18 @@ public:
   void
   deleteBlock(const Name& name) override;
 
+  void
+  replaceBlock(const Name& name, const Block& block) override;
+
+  void
+  forEachName(const Name& prefix, const std::function<void(const Name&)>& visit) override;
+
   Interface
   getInterface() override;
 
 private:
+  // the DAG worker thread and the io_context thread may share the storage
+  std::mutex m_mutex;
   std::map<Name, Block> m_list;
 };
 
@@ -9,10 +9,13 @@ namespace storage {
 using Adder = std::function<void(const Name&, const Block&)>;
 using Getter = std::function<Block(const Name&)>;
 using Deleter = std::function<void(const Name&)>;
+// adds, or overwrites in one step, so readers never see the name missing
+using Replacer = std::function<void(const Name&, const Block&)>;
 struct Interface {
   Adder adder;
   Getter getter;
   Deleter deleter;
+  Replacer replacer;
 };
 
 class LedgerStorage : boost::noncopyable
@@ -28,6 +31,20 @@ public:
   virtual void
   deleteBlock(const Name& name) = 0;
 
+  /**
+   * @brief Store @p block under @p name, overwriting any block already there atomically.
+   */
+  virtual void
+  replaceBlock(const Name& name, const Block& block) = 0;
+
+  /**
+   * @brief Call @p visit with every stored name strictly under @p prefix, in no set order.
+   *
+   * Only the names are read, e.g., to rebuild an in-memory index from keys that embed it.
+   */
+  virtual void
+  forEachName(const Name& prefix, const std::function<void(const Name&)>& visit) = 0;
+
   virtual Interface
   getInterface() = 0;
 
@@ -0,0 +1,61 @@
+#include "util/bitset.hpp"
+
+namespace cledger::util {
+
+void
+orWords(uint64_t* __restrict dst, const uint64_t* __restrict src, size_t nWords)
+{
+  for (size_t i = 0; i < nWords; i++) {
+    dst[i] |= src[i];
+  }
+}
+
+size_t
+countWords(const uint64_t* src, size_t nWords)
+{
+  size_t ret = 0;
+  for (size_t i = 0; i < nWords; i++) {
+    ret += __builtin_popcountll(src[i]);
+  }
+  return ret;
+}
+
+void
+Bitset::set(size_t pos)
+{
+  size_t word = pos / WORD_BITS;
+  if (word >= m_words.size()) {
+    m_words.resize(word + 1, 0);
+  }
+  m_words[word] |= Word(1) << (pos % WORD_BITS);
+}
+
+bool
+Bitset::test(size_t pos) const
+{
+  size_t word = pos / WORD_BITS;
+  if (word >= m_words.size()) {
+    return false;
+  }
+  return (m_words[word] >> (pos % WORD_BITS)) & 1;
+}
+
+size_t
+Bitset::count() const
+{
+  return countWords(m_words.data(), m_words.size());
+}
+
+Bitset&
+Bitset::operator|=(const Bitset& other)
+{
+  if (other.m_words.size() > m_words.size()) {
+    m_words.resize(other.m_words.size(), 0);
+  }
+  if (this != &other) {
+    orWords(m_words.data(), other.m_words.data(), other.m_words.size());
+  }
+  return *this;
+}
+
+} // namespace cledger::util
@@ -0,0 +1,86 @@
+#ifndef CLEDGER_UTIL_BITSET_HPP
+#define CLEDGER_UTIL_BITSET_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace cledger::util {
+
+/**
+ * @brief dst[i] |= src[i] for i in [0, nWords)
+ *
+ * Plain word loop over non-aliasing rows so that the compiler can vectorize it
+ * (AVX2 on x86-64, NEON on aarch64).
+ */
+void
+orWords(uint64_t* __restrict dst, const uint64_t* __restrict src, size_t nWords);
+
+/**
+ * @brief Number of bits set in [src, src + nWords)
+ */
+size_t
+countWords(const uint64_t* src, size_t nWords);
+
+/**
+ * @brief A growable bitset over dense IDs.
+ *
+ * Bits are stored in 64-bit words and the set grows on demand, so it can be keyed
+ * by IDs handed out by an interning table without knowing the universe size upfront.
+ */
+class Bitset
+{
+public:
+  using Word = uint64_t;
+  static constexpr size_t WORD_BITS = 64;
+
+  void
+  set(size_t pos);
+
+  bool
+  test(size_t pos) const;
+
+  /**
+   * @brief Number of bits set (popcount over all words).
+   */
+  size_t
+  count() const;
+
+  Bitset&
+  operator|=(const Bitset& other);
+
+  void
+  clear()
+  {
+    m_words.clear();
+  }
+
+  size_t
+  capacity() const
+  {
+    return m_words.size() * WORD_BITS;
+  }
+
+  /**
+   * @brief The words, lowest bits first, e.g., to store the set.
+   */
+  const std::vector<Word>&
+  getWords() const
+  {
+    return m_words;
+  }
+
+  void
+  setWords(std::vector<Word> words)
+  {
+    m_words = std::move(words);
+  }
+
+private:
+  std::vector<Word> m_words;
+};
+
+} // namespace cledger::util
+
+#endif // CLEDGER_UTIL_BITSET_HPP
@@ -0,0 +1,95 @@
+#include "util/bloom-filter.hpp"
+
+#include <cmath>
+
+namespace cledger::util {
+
+enum : uint32_t {
+  TLV_BLOOM_FILTER = 481,
+  TLV_BLOOM_FILTER_BIT_COUNT = 482,
+  TLV_BLOOM_FILTER_HASH_COUNT = 483,
+  TLV_BLOOM_FILTER_BITS = 484,
+};
+
+static std::pair<uint64_t, uint64_t>
+hashName(const Name& name)
+{
+  // FNV-1a, then a SplitMix64 finalizer for the second, odd so that it steps over all bits
+  uint64_t h1 = 0xcbf29ce484222325;
+  for (auto byte : name.wireEncode()) {
+    h1 = (h1 ^ byte) * 0x100000001b3;
+  }
+  uint64_t h2 = h1 + 0x9e3779b97f4a7c15;
+  h2 = (h2 ^ (h2 >> 30)) * 0xbf58476d1ce4e5b9;
+  h2 = (h2 ^ (h2 >> 27)) * 0x94d049bb133111eb;
+  h2 ^= h2 >> 31;
+  return {h1, h2 | 1};
+}
+
+BloomFilter::BloomFilter(size_t capacity, double fpRate)
+{
+  auto n = static_cast<double>(std::max<size_t>(capacity, 1));
+  m_nBits = std::max<size_t>(std::ceil(-n * std::log(fpRate) / (std::log(2) * std::log(2))), 64);
+  m_nHashes = std::max<size_t>(std::lround(m_nBits / n * std::log(2)), 1);
+}
+
+void
+BloomFilter::insert(const Name& name)
+{
+  auto [h1, h2] = hashName(name);
+  for (size_t i = 0; i < m_nHashes; i++) {
+    m_bits.set((h1 + i * h2) % m_nBits);
+  }
+}
+
+bool
+BloomFilter::mayContain(const Name& name) const
+{
+  auto [h1, h2] = hashName(name);
+  for (size_t i = 0; i < m_nHashes; i++) {
+    if (!m_bits.test((h1 + i * h2) % m_nBits)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Block
+BloomFilter::encode() const
+{
+  // little-endian words, whatever the host
+  const auto& words = m_bits.getWords();
+  Buffer bits(words.size() * sizeof(Bitset::Word));
+  for (size_t i = 0; i < bits.size(); i++) {
+    bits[i] = static_cast<uint8_t>(words[i / sizeof(Bitset::Word)] >> (8 * (i % sizeof(Bitset::Word))));
+  }
+  Block block(TLV_BLOOM_FILTER);
+  block.push_back(ndn::makeNonNegativeIntegerBlock(TLV_BLOOM_FILTER_BIT_COUNT, m_nBits));
+  block.push_back(ndn::makeNonNegativeIntegerBlock(TLV_BLOOM_FILTER_HASH_COUNT, m_nHashes));
+  block.push_back(ndn::makeBinaryBlock(TLV_BLOOM_FILTER_BITS, bits));
+  block.encode();
+  return block;
+}
+
+void
+BloomFilter::restore(const Block& block)
+{
+  block.parse();
+  if (block.type() != TLV_BLOOM_FILTER ||
+      ndn::readNonNegativeInteger(block.get(TLV_BLOOM_FILTER_BIT_COUNT)) != m_nBits ||
+      ndn::readNonNegativeInteger(block.get(TLV_BLOOM_FILTER_HASH_COUNT)) != m_nHashes) {
+    NDN_THROW(std::runtime_error("Not a Bloom filter of " + std::to_string(m_nBits) + " bits"));
+  }
+  const auto& bits = block.get(TLV_BLOOM_FILTER_BITS);
+  auto nWords = (m_nBits + Bitset::WORD_BITS - 1) / Bitset::WORD_BITS;
+  if (bits.value_size() % sizeof(Bitset::Word) != 0 || bits.value_size() / sizeof(Bitset::Word) > nWords) {
+    NDN_THROW(std::runtime_error("Bloom filter bits are corrupted"));
+  }
+  std::vector<Bitset::Word> words(bits.value_size() / sizeof(Bitset::Word), 0);
+  for (size_t i = 0; i < bits.value_size(); i++) {
+    words[i / sizeof(Bitset::Word)] |= Bitset::Word(bits.value()[i]) << (8 * (i % sizeof(Bitset::Word)));
+  }
+  m_bits.setWords(std::move(words));
+}
+
+} // namespace cledger::util
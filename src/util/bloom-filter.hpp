@@ -0,0 +1,64 @@
+#ifndef CLEDGER_UTIL_BLOOM_FILTER_HPP
+#define CLEDGER_UTIL_BLOOM_FILTER_HPP
+
+#include "cledger-common.hpp"
+#include "util/bitset.hpp"
+
+namespace cledger::util {
+
+/**
+ * @brief A Bloom filter over Names.
+ *
+ * Sized for @p capacity Names at a false positive rate of @p fpRate; past that the rate
+ * goes up, but a Name that was inserted is always reported. The k bit positions come from
+ * two 64-bit hashes of the Name's wire encoding (Kirsch-Mitzenmacher double hashing).
+ */
+class BloomFilter
+{
+public:
+  explicit
+  BloomFilter(size_t capacity, double fpRate = 0.01);
+
+  void
+  insert(const Name& name);
+
+  /**
+   * @return false if @p name was definitely never inserted
+   */
+  bool
+  mayContain(const Name& name) const;
+
+  size_t
+  getBitCount() const
+  {
+    return m_nBits;
+  }
+
+  size_t
+  getHashCount() const
+  {
+    return m_nHashes;
+  }
+
+  /**
+   * @brief The filter's size and bits, to be given back to restore().
+   */
+  Block
+  encode() const;
+
+  /**
+   * @brief Take the bits of an encoded filter of the same size.
+   * @throw std::runtime_error @p block is not a filter of this size
+   */
+  void
+  restore(const Block& block);
+
+private:
+  size_t m_nBits;
+  size_t m_nHashes;
+  Bitset m_bits;
+};
+
+} // namespace cledger::util
+
+#endif // CLEDGER_UTIL_BLOOM_FILTER_HPP
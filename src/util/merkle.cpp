@@ -0,0 +1,83 @@
+#include "util/merkle.hpp"
+
+#include <algorithm>
+
+namespace cledger::util::merkle {
+
+const uint8_t LEAF_PREFIX = 0x00;
+const uint8_t NODE_PREFIX = 0x01;
+
+ndn::ConstBufferPtr
+hashLeaf(span<const uint8_t> data)
+{
+  Sha256 digest;
+  digest.update({&LEAF_PREFIX, 1});
+  digest.update(data);
+  return digest.computeDigest();
+}
+
+ndn::ConstBufferPtr
+hashChildren(span<const uint8_t> left, span<const uint8_t> right)
+{
+  Sha256 digest;
+  digest.update({&NODE_PREFIX, 1});
+  digest.update(left);
+  digest.update(right);
+  return digest.computeDigest();
+}
+
+static ndn::ConstBufferPtr
+computeRoot(const std::vector<ndn::ConstBufferPtr>& leafHashes, size_t begin, size_t end)
+{
+  if (end - begin == 1) {
+    return leafHashes[begin];
+  }
+  size_t split = 1;
+  while (split * 2 < end - begin) {
+    split *= 2;
+  }
+  auto left = computeRoot(leafHashes, begin, begin + split);
+  auto right = computeRoot(leafHashes, begin + split, end);
+  return hashChildren(*left, *right);
+}
+
+ndn::ConstBufferPtr
+computeRoot(const std::vector<ndn::ConstBufferPtr>& leafHashes)
+{
+  if (leafHashes.empty()) {
+    return Sha256().computeDigest();
+  }
+  return computeRoot(leafHashes, 0, leafHashes.size());
+}
+
+bool
+verifyInclusion(span<const uint8_t> leafHash, uint64_t leafIndex, uint64_t treeSize,
+                const std::vector<Buffer>& path, span<const uint8_t> root)
+{
+  if (leafIndex >= treeSize) {
+    return false;
+  }
+  uint64_t fn = leafIndex;
+  uint64_t sn = treeSize - 1;
+  ndn::ConstBufferPtr r = std::make_shared<Buffer>(leafHash.begin(), leafHash.end());
+  for (auto& p : path) {
+    if (sn == 0) {
+      return false;
+    }
+    if ((fn & 1) || fn == sn) {
+      r = hashChildren(p, *r);
+      while (!(fn & 1) && fn != 0) {
+        fn >>= 1;
+        sn >>= 1;
+      }
+    }
+    else {
+      r = hashChildren(*r, p);
+    }
+    fn >>= 1;
+    sn >>= 1;
+  }
+  return sn == 0 && std::equal(r->begin(), r->end(), root.begin(), root.end());
+}
+
+} // namespace cledger::util::merkle
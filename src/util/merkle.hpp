@@ -0,0 +1,43 @@
+#ifndef CLEDGER_UTIL_MERKLE_HPP
+#define CLEDGER_UTIL_MERKLE_HPP
+
+#include "cledger-common.hpp"
+
+namespace cledger::util::merkle {
+
+/**
+ * @brief SHA-256(0x00 || data), the hash of a tree leaf (RFC 6962, section 2.1).
+ */
+ndn::ConstBufferPtr
+hashLeaf(span<const uint8_t> data);
+
+/**
+ * @brief SHA-256(0x01 || left || right), the hash of an inner node.
+ *
+ * The distinct prefixes keep a leaf from being passed off as an inner node.
+ */
+ndn::ConstBufferPtr
+hashChildren(span<const uint8_t> left, span<const uint8_t> right);
+
+/**
+ * @brief Merkle Tree Hash over leaf hashes, in order (RFC 6962, section 2.1).
+ *
+ * A tree of n > 1 leaves splits at the largest power of two smaller than n.
+ * The root of an empty tree is the hash of the empty string.
+ */
+ndn::ConstBufferPtr
+computeRoot(const std::vector<ndn::ConstBufferPtr>& leafHashes);
+
+/**
+ * @brief Check an audit path from a leaf to the root of a tree of @p treeSize leaves.
+ *
+ * Follows the verification algorithm of RFC 9162, section 2.1.3.2; the path is
+ * ordered from the leaf's sibling up to the root's children.
+ */
+bool
+verifyInclusion(span<const uint8_t> leafHash, uint64_t leafIndex, uint64_t treeSize,
+                const std::vector<Buffer>& path, span<const uint8_t> root);
+
+} // namespace cledger::util::merkle
+
+#endif // CLEDGER_UTIL_MERKLE_HPP
@@ -0,0 +1,123 @@
+#ifndef CLEDGER_UTIL_MPSC_QUEUE_HPP
+#define CLEDGER_UTIL_MPSC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <boost/noncopyable.hpp>
+
+namespace cledger::util {
+
+/**
+ * @brief Bounded lock-free multi-producer single-consumer queue.
+ *
+ * A ring of cells tagged with sequence numbers (D. Vyukov's bounded queue): producers
+ * claim a slot with one CAS on the enqueue position and publish it by bumping the cell's
+ * sequence, so neither side ever blocks. The capacity is rounded up to a power of two.
+ *
+ * @tparam T default constructible and move assignable
+ */
+template<typename T>
+class MpscQueue : boost::noncopyable
+{
+public:
+  explicit
+  MpscQueue(size_t capacity)
+  {
+    size_t size = 2;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    m_mask = size - 1;
+    m_cells = std::make_unique<Cell[]>(size);
+    for (size_t i = 0; i < size; i++) {
+      m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * @brief Enqueue an item, may be called from any thread.
+   * @return false if the queue is full, in which case @p item is left untouched
+   */
+  bool
+  push(T&& item)
+  {
+    Cell* cell;
+    size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+    while (true) {
+      cell = &m_cells[pos & m_mask];
+      size_t seq = cell->sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      }
+      else if (diff < 0) {
+        return false;
+      }
+      else {
+        pos = m_enqueuePos.load(std::memory_order_relaxed);
+      }
+    }
+    cell->data = std::move(item);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Dequeue an item, must only be called from the consumer thread.
+   * @return false if no published item is available
+   */
+  bool
+  pop(T& item)
+  {
+    size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+    Cell* cell = &m_cells[pos & m_mask];
+    size_t seq = cell->sequence.load(std::memory_order_acquire);
+    if (static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1) < 0) {
+      return false;
+    }
+    m_dequeuePos.store(pos + 1, std::memory_order_relaxed);
+    item = std::move(cell->data);
+    cell->sequence.store(pos + m_mask + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Whether every claimed slot has been dequeued.
+   *
+   * A claimed slot may not be published yet, so pop() can still fail right after
+   * this returns false.
+   */
+  bool
+  empty() const
+  {
+    return m_enqueuePos.load(std::memory_order_acquire) ==
+           m_dequeuePos.load(std::memory_order_acquire);
+  }
+
+  size_t
+  capacity() const
+  {
+    return m_mask + 1;
+  }
+
+private:
+  struct Cell
+  {
+    std::atomic<size_t> sequence;
+    T data;
+  };
+
+  std::unique_ptr<Cell[]> m_cells;
+  size_t m_mask;
+  alignas(64) std::atomic<size_t> m_enqueuePos{0};
+  alignas(64) std::atomic<size_t> m_dequeuePos{0};
+};
+
+} // namespace cledger::util
+
+#endif // CLEDGER_UTIL_MPSC_QUEUE_HPP
@@ -44,6 +44,9 @@ Consumer::run(const Name& versionedName, shared_ptr<PipelineInterests> pipeline)
   m_pipeline = std::move(pipeline);
   m_nextToPrint = 0;
   m_bufferedData.clear();
+  m_manifest = nullopt;
+  m_hasNoManifest = false;
+  m_awaitingManifest.clear();
 
   m_pipeline->run(versionedName,
                   FORWARD_TO_MEM_FN(handleData),
@@ -56,12 +59,51 @@ Consumer::handleData(const Data& data)
   auto dataPtr = data.shared_from_this();
   NDN_LOG_TRACE("SegmentConsumer received " << data.getName());
 
+  if (getSegmentFromPacket(data) > 0 && data.getSignatureType() == ndn::tlv::DigestSha256) {
+    // covered by the manifest in segment 0 instead of the validator
+    if (m_hasNoManifest) {
+      NDN_THROW(std::runtime_error("SegmentConsumer: " + data.getName().toUri() + " has no manifest to match"));
+    }
+    if (!m_manifest) {
+      m_awaitingManifest.push_back(dataPtr);
+      return;
+    }
+    acceptFromManifest(dataPtr);
+    return writeInOrderData();
+  }
+
   m_validator.validate(data,
     [this, dataPtr] (const Data& data) {
       if (data.getContentType() == ndn::tlv::ContentType_Nack) {
         NDN_THROW(std::runtime_error("Internal error of SegmentConsumer: " + data.getName().toUri()));
       }
 
+      if (data.getContentType() == ndn::tlv::ContentType_Manifest) {
+        if (getSegmentFromPacket(data) != 0) {
+          NDN_THROW(std::runtime_error("SegmentConsumer: " + data.getName().toUri() + " is a manifest but not segment 0"));
+        }
+        m_manifest.emplace();
+        const auto& content = data.getContent();
+        content.parse();
+        for (const auto& digest : content.elements()) {
+          m_manifest->emplace_back(digest);
+        }
+        NDN_LOG_TRACE("SegmentConsumer received a manifest of " << m_manifest->size() << " segments");
+        auto awaiting = std::move(m_awaitingManifest);
+        m_awaitingManifest.clear();
+        for (const auto& segment : awaiting) {
+          acceptFromManifest(segment);
+        }
+      }
+      else if (getSegmentFromPacket(data) == 0) {
+        // no manifest is coming, DigestSha256 segments cannot be trusted
+        m_hasNoManifest = true;
+        if (!m_awaitingManifest.empty()) {
+          NDN_THROW(std::runtime_error("SegmentConsumer: " + m_awaitingManifest.front()->getName().toUri() +
+                                       " has no manifest to match"));
+        }
+      }
+
       // 'data' passed to callback comes from DataValidationState and was not created with make_shared
       m_bufferedData[getSegmentFromPacket(data)] = dataPtr;
       writeInOrderData();
@@ -71,6 +113,16 @@ Consumer::handleData(const Data& data)
     });
 }
 
+void
+Consumer::acceptFromManifest(const shared_ptr<const Data>& data)
+{
+  auto segmentNo = getSegmentFromPacket(*data);
+  if (segmentNo > m_manifest->size() || data->getFullName().get(-1) != (*m_manifest)[segmentNo - 1]) {
+    NDN_THROW(std::runtime_error("SegmentConsumer: " + data->getName().toUri() + " does not match the manifest"));
+  }
+  m_bufferedData[segmentNo] = data;
+}
+
 void
 Consumer::writeInOrderData()
 {
@@ -78,11 +130,16 @@ Consumer::writeInOrderData()
        it != m_bufferedData.end() && it->first == m_nextToPrint;
        it = m_bufferedData.erase(it), ++m_nextToPrint) {
     NDN_LOG_TRACE("SegmentConsumer writes in order data " << it->second->getName());
+    if (it->second->getContentType() == ndn::tlv::ContentType_Manifest) {
+      // not part of the object
+      continue;
+    }
     const Block& content = it->second->getContent();
     Buffer currSegmentBuffer(content.value(), content.value_size());
     m_outputBuffer.insert(m_outputBuffer.end(), currSegmentBuffer.begin(), currSegmentBuffer.end());
   }
-  if (m_pipeline->allSegmentsReceived()) {
+  // segments waiting for the manifest or for their turn are not written yet
+  if (m_pipeline->allSegmentsReceived() && m_bufferedData.empty() && m_awaitingManifest.empty()) {
     NDN_LOG_DEBUG("SegmentConsumer receives all segments");
     auto block = make_shared<Block>(m_outputBuffer);
     m_finishCb(*block);
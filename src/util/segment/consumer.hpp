@@ -44,6 +44,10 @@ namespace cledger::util::segment {
  * Discover the latest version of the data published under a specified prefix, and retrieve all the
  * segments associated to that version. The segments are fetched in order and written to a
  * user-specified stream in the same order.
+ *
+ * When segment 0 is a Manifest, it is the only segment given to the validator; the others
+ * are DigestSha256-signed and accepted if their implicit digest is the one listed for them.
+ * Once segment 0 turns out not to be a Manifest, a DigestSha256 segment fails the fetch.
  */
 class Consumer : noncopyable
 {
@@ -65,6 +69,9 @@ private:
   void
   handleData(const Data& data);
 
+  void
+  acceptFromManifest(const shared_ptr<const Data>& data);
+
   void
   writeInOrderData();
 
@@ -75,6 +82,12 @@ private:
   uint64_t m_nextToPrint = 0;
 
   std::map<uint64_t, shared_ptr<const Data>> m_bufferedData;
+  // digests of segment 1 onwards, from a validated manifest
+  optional<std::vector<Name::Component>> m_manifest;
+  // segment 0 was validated and is not a manifest
+  bool m_hasNoManifest = false;
+  // DigestSha256 segments that came before the manifest
+  std::vector<shared_ptr<const Data>> m_awaitingManifest;
   FinishCallback m_finishCb;
 };
 
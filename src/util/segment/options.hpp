@@ -32,12 +32,14 @@
 
 namespace cledger::util::segment {
 
-struct Options : noncopyable
+struct Options
 {
   // Common options
   time::milliseconds interestLifetime = ndn::DEFAULT_INTEREST_LIFETIME;
   int maxRetriesOnTimeoutOrNack = 15;
   bool mustBeFresh = false;
+  // for segments served under a prefix the producer has not registered
+  std::vector<Name> forwardingHint;
 
   // Fixed pipeline options
   size_t maxPipelineSize = 1;
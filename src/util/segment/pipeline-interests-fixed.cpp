@@ -75,6 +75,7 @@ PipelineInterestsFixed::fetchNextSegment(std::size_t pipeNo)
   auto interest = Interest()
                   .setName(Name(m_prefix).appendSegment(nextSegmentNo))
                   .setMustBeFresh(m_options.mustBeFresh)
+                  .setForwardingHint(m_options.forwardingHint)
                   .setInterestLifetime(m_options.interestLifetime);
 
   auto fetcher = DataFetcher::fetch(m_face, interest,
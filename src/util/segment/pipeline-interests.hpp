@@ -54,6 +54,7 @@ public:
    *
    * Configures the pipelining service without specifying the retrieval namespace.
    * After construction, the method run() must be called in order to start the pipeline.
+   * The pipeline keeps a copy of @p opts, e.g., the forwarding hint of its own session.
    */
   PipelineInterests(Face& face, const Options& opts);
 
@@ -141,7 +142,7 @@ private:
   doCancel() = 0;
 
 protected:
-  const Options& m_options;
+  const Options m_options;
   Face& m_face;
   Name m_prefix;
   bool m_hasFinalBlockId = false; ///< true if the last segment number is known
@@ -89,22 +89,22 @@ Producer::~Producer()
 void
 Producer::processSegmentInterest(const Interest& interest)
 {
-  BOOST_ASSERT(!m_store.empty());
+  BOOST_ASSERT(m_store != nullptr);
   NDN_LOG_TRACE("SegmentProducer Interest: " << interest);
 
   const Name& name = interest.getName();
-  shared_ptr<Data> data;
+  const Data* data = nullptr;
 
   if (name.size() == m_versionedPrefix.size() + 1 && name[-1].isSegment()) {
     const auto segmentNo = static_cast<size_t>(interest.getName()[-1].toSegment());
-    // specific segment retrieval
-    if (segmentNo < m_store.size()) {
-      data = m_store[segmentNo];
+    // specific segment retrieval, signed on the first request
+    if (segmentNo < m_store->size()) {
+      data = &m_store->getSegment(segmentNo);
     }
   }
-  else if (interest.matchesData(*m_store[0])) {
+  else if (interest.matchesData(m_store->getSegment(0))) {
     // unspecified version or segment number, return first segment
-    data = m_store[0];
+    data = &m_store->getSegment(0);
   }
 
   if (data != nullptr) {
@@ -119,38 +119,9 @@ Producer::processSegmentInterest(const Interest& interest)
 void
 Producer::populateStore(const Block& block)
 {
-  BOOST_ASSERT(m_store.empty());
+  BOOST_ASSERT(m_store == nullptr);
   NDN_LOG_TRACE("SegmentProducer loading input..");
-
-  std::vector<uint8_t> buffer(m_options.maxSegmentSize);
-  
-  int total = (block.size() - 1) / m_options.maxSegmentSize + 1;
-  int count = 0;
-  while (count < total) {
-    int copyOffset = count++ * m_options.maxSegmentSize;
-    int copySize = m_options.maxSegmentSize < block.size() - copyOffset?
-                   m_options.maxSegmentSize : block.size() - copyOffset;
-    NDN_LOG_DEBUG("SegmentProducer created No." << count << " chunk with " << copySize << " Bytes");
-    std::memcpy(buffer.data(), block.data() + copyOffset, copySize);
-    auto data = make_shared<Data>(Name(m_versionedPrefix).appendSegment(m_store.size()));
-    data->setFreshnessPeriod(m_options.freshnessPeriod);
-    data->setContent(make_span(buffer.data(), copySize));
-    m_store.push_back(data);
-    buffer.clear();
-  }
-
-  if (m_store.empty()) {
-    auto data = make_shared<Data>(Name(m_versionedPrefix).appendSegment(0));
-    data->setFreshnessPeriod(m_options.freshnessPeriod);
-    m_store.push_back(data);
-  }
-
-  auto finalBlockId = Name::Component::fromSegment(m_store.size() - 1);
-  for (const auto& data : m_store) {
-    data->setFinalBlock(finalBlockId);
-    m_keyChain.sign(*data, m_options.signingInfo);
-  }
-  NDN_LOG_DEBUG("SegmentProducer created " << m_store.size() << " chunks for prefix " << m_prefix);
+  m_store = make_unique<SegmentedObject>(m_versionedPrefix, block, m_keyChain, m_options);
 }
 
 } // namespace ndn::chunks
@@ -31,7 +31,7 @@
 #ifndef CLEDGER_UTIL_SEGMENT_PRODUCER_HPP
 #define CLEDGER_UTIL_SEGMENT_PRODUCER_HPP
 
-#include "util/segment/segment-common.hpp"
+#include "util/segment/segmented-object.hpp"
 
 namespace cledger::util::segment {
 
@@ -41,16 +41,12 @@ namespace cledger::util::segment {
  * Packetizes and publishes data from an input stream as `/prefix/<version>/<segment number>`.
  * Unless another value is provided, the current time is used as the version number.
  * The packet store always has at least one item, even when the input is empty.
+ * Segments after the first are signed when first requested.
  */
 class Producer : noncopyable
 {
 public:
-  struct Options
-  {
-    SigningInfo signingInfo;
-    time::milliseconds freshnessPeriod = 10_s;
-    size_t maxSegmentSize = 8000;
-  };
+  using Options = SegmentedObject::Options;
 
 public:
   /**
@@ -63,10 +59,10 @@ public:
 
   ~Producer();
 
-  const std::vector<shared_ptr<Data>>&
+  const SegmentedObject&
   getDataStore() const
   {
-    return m_store;
+    return *m_store;
   }
 
 private:
@@ -75,7 +71,7 @@ private:
    *
    * Create data packets reading all the characters from the input stream until EOF or an
    * error occurs. Each data packet has a maximum payload size of `m_options.maxSegmentSize`
-   * bytes and is stored in the vector `m_store`. An empty data packet is created and stored
+   * bytes and is stored in `m_store`. An empty data packet is created and stored
    * if the input stream is empty.
    *
    * @return Number of data packets contained in the store after the operation
@@ -89,7 +85,7 @@ private:
   void
   processSegmentInterest(const Interest& interest);
 
-  std::vector<shared_ptr<Data>> m_store;
+  unique_ptr<SegmentedObject> m_store;
 
 private:
   Name m_prefix;
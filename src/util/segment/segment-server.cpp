@@ -0,0 +1,119 @@
+#include "util/segment/segment-server.hpp"
+
+namespace cledger::util::segment {
+
+NDN_LOG_INIT(cledger.util);
+
+SegmentServer::SegmentServer(Face& face, const Options& opts)
+  : m_face(face)
+  , m_scheduler(face.getIoContext())
+  , m_options(opts)
+{
+  // one more slot than the session needs, as the first tick comes early by up to a tick
+  auto nSlots = (m_options.sessionLength.count() + m_options.tick.count() - 1) / m_options.tick.count();
+  m_wheel.resize(std::max<size_t>(nSlots, 1) + 1);
+}
+
+void
+SegmentServer::publish(shared_ptr<const SegmentedObject> object)
+{
+  const Name& name = object->getVersionedName();
+  auto it = m_sessions.find(name);
+  if (it != m_sessions.end()) {
+    m_wheel[it->second.slot].erase(it->second.pos);
+    m_bytes -= it->second.bytes;
+    it->second.object = object;
+  }
+  else {
+    it = m_sessions.emplace(name, Session{object, 0, {}, 0}).first;
+  }
+  // the slot right behind the cursor comes around last
+  auto slot = (m_cursor + m_wheel.size() - 1) % m_wheel.size();
+  it->second.slot = slot;
+  it->second.pos = m_wheel[slot].insert(m_wheel[slot].end(), name);
+  it->second.bytes = object->getBytes();
+  m_bytes += it->second.bytes;
+  NDN_LOG_DEBUG("SegmentServer starts a session hosting " << name);
+
+  // never drop the session just started
+  shrink(name);
+
+  if (!m_tickEvent) {
+    m_tickEvent = m_scheduler.schedule(m_options.tick, [this] { onTick(); });
+  }
+}
+
+bool
+SegmentServer::serve(const Interest& interest)
+{
+  const Name& name = interest.getName();
+  if (name.empty() || !(name[-1].isSegment() || name[-1].isVersion())) {
+    return false;
+  }
+
+  auto it = m_sessions.find(name[-1].isSegment() ? name.getPrefix(-1) : name);
+  if (it == m_sessions.end()) {
+    return false;
+  }
+  const auto& object = *it->second.object;
+  // a version alone asks for the first segment
+  auto segmentNo = name[-1].isSegment() ? name[-1].toSegment() : 0;
+  if (segmentNo < object.size()) {
+    const auto& data = object.getSegment(segmentNo);
+    NDN_LOG_TRACE("SegmentServer Data: " << data.getName());
+    m_face.put(data);
+
+    // a segment signed just now is held from here on
+    if (object.getBytes() != it->second.bytes) {
+      m_bytes += object.getBytes() - it->second.bytes;
+      it->second.bytes = object.getBytes();
+      shrink(it->first);
+    }
+  }
+  else {
+    m_face.put(ndn::lp::Nack(interest));
+  }
+  return true;
+}
+
+void
+SegmentServer::shrink(const Name& keep)
+{
+  for (size_t i = 0; i < m_wheel.size() && m_bytes > m_options.memoryBudget; i++) {
+    auto& sessions = m_wheel[(m_cursor + i) % m_wheel.size()];
+    for (auto n = sessions.begin(); n != sessions.end() && m_bytes > m_options.memoryBudget;) {
+      if (*n == keep) {
+        ++n;
+        continue;
+      }
+      NDN_LOG_DEBUG("SegmentServer over memory budget, drops " << *n);
+      erase(m_sessions.find(*(n++)));
+    }
+  }
+}
+
+void
+SegmentServer::onTick()
+{
+  m_tickEvent = {};
+  auto& expired = m_wheel[m_cursor];
+  while (!expired.empty()) {
+    NDN_LOG_DEBUG("SegmentServer stops a session hosting " << expired.front());
+    erase(m_sessions.find(expired.front()));
+  }
+  m_cursor = (m_cursor + 1) % m_wheel.size();
+
+  if (!m_sessions.empty()) {
+    m_tickEvent = m_scheduler.schedule(m_options.tick, [this] { onTick(); });
+  }
+}
+
+void
+SegmentServer::erase(SessionMap::iterator it)
+{
+  m_bytes -= it->second.bytes;
+  m_wheel[it->second.slot].erase(it->second.pos);
+  m_sessions.erase(it);
+}
+
+} // namespace cledger::util::segment
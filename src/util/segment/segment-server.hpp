@@ -0,0 +1,102 @@
+#ifndef CLEDGER_UTIL_SEGMENT_SEGMENT_SERVER_HPP
+#define CLEDGER_UTIL_SEGMENT_SEGMENT_SERVER_HPP
+
+#include "util/segment/segmented-object.hpp"
+
+#include <list>
+#include <unordered_map>
+
+namespace cledger::util::segment {
+
+/**
+ * @brief One Interest handler serving the segments of every outstanding response
+ *
+ * Unlike a Producer per response, nothing is registered when an object is published;
+ * the owner forwards the Interests under its prefixes to serve(). Sessions are found
+ * by versioned Name and expire on a timing wheel of `sessionLength / tick` slots, so
+ * publishing and expiring are O(1). When the segments held go over the memory budget,
+ * the sessions closest to expiry are dropped first. As objects sign their segments on
+ * demand, what a session holds is accounted again each time it serves a segment.
+ */
+class SegmentServer : noncopyable
+{
+public:
+  struct Options
+  {
+    time::milliseconds sessionLength = 30_s;
+    time::milliseconds tick = 1_s;
+    // bytes of segments held by all sessions
+    size_t memoryBudget = 64 * 1024 * 1024;
+  };
+
+public:
+  SegmentServer(Face& face, const Options& opts);
+
+  /**
+   * @brief Serve @p object for a session, restarting the session if it is already served
+   */
+  void
+  publish(shared_ptr<const SegmentedObject> object);
+
+  /**
+   * @brief Answer @p interest if it names a segment, or the version, of a served object
+   *
+   * A segment number beyond the last segment is answered with a network Nack.
+   *
+   * @return false if @p interest is not for a served object
+   */
+  bool
+  serve(const Interest& interest);
+
+  size_t
+  size() const
+  {
+    return m_sessions.size();
+  }
+
+  size_t
+  getBytes() const
+  {
+    return m_bytes;
+  }
+
+private:
+  void
+  onTick();
+
+  /**
+   * @brief Drop the sessions closest to expiry until under budget, except @p keep
+   */
+  void
+  shrink(const Name& keep);
+
+private:
+  struct Session
+  {
+    shared_ptr<const SegmentedObject> object;
+    size_t slot;
+    std::list<Name>::iterator pos;
+    // the object's size as last added to m_bytes
+    size_t bytes;
+  };
+
+  using SessionMap = std::unordered_map<Name, Session>;
+
+  void
+  erase(SessionMap::iterator it);
+
+  Face& m_face;
+  Scheduler m_scheduler;
+  const Options m_options;
+
+  SessionMap m_sessions;
+  // the sessions expiring at each tick, m_cursor is the next to expire
+  std::vector<std::list<Name>> m_wheel;
+  size_t m_cursor = 0;
+  size_t m_bytes = 0;
+  ndn::scheduler::EventId m_tickEvent;
+};
+
+} // namespace cledger::util::segment
+
+#endif // CLEDGER_UTIL_SEGMENT_SEGMENT_SERVER_HPP
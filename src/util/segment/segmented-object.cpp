@@ -0,0 +1,85 @@
+#include "util/segment/segmented-object.hpp"
+
+#include <ndn-cxx/security/signing-helpers.hpp>
+
+namespace cledger::util::segment {
+
+NDN_LOG_INIT(cledger.util);
+
+SegmentedObject::SegmentedObject(const Name& versionedName, const Block& block, KeyChain& keyChain,
+                                 const Options& opts)
+  : m_versionedName(versionedName)
+  , m_keyChain(keyChain)
+  , m_signingInfo(opts.signingInfo)
+  , m_freshnessPeriod(opts.freshnessPeriod)
+  , m_maxSegmentSize(opts.maxSegmentSize)
+  , m_content(block)
+{
+  size_t nChunks = block.size() == 0 ? 1 : (block.size() - 1) / opts.maxSegmentSize + 1;
+  // an ImplicitSha256DigestComponent per chunk
+  constexpr size_t digestSize = 2 + Sha256::DIGEST_SIZE;
+  bool withManifest = opts.useManifest && nChunks > 1 && nChunks * digestSize <= opts.maxSegmentSize;
+  size_t total = withManifest ? nChunks + 1 : nChunks;
+  m_firstChunk = withManifest ? 1 : 0;
+
+  // the content is shared with the caller, the segments are only named here
+  m_segments.resize(total);
+  m_isSigned.resize(total, false);
+  m_bytes = m_content.size() + total * Name(m_versionedName).appendSegment(total - 1).wireEncode().size();
+
+  if (withManifest) {
+    Block manifest(ndn::tlv::Content);
+    for (size_t i = 1; i < total; i++) {
+      makeSegment(i);
+      m_keyChain.sign(m_segments[i], ndn::signingWithSha256());
+      m_isSigned[i] = true;
+      m_bytes += m_segments[i].wireEncode().size();
+      manifest.push_back(m_segments[i].getFullName().get(-1).wireEncode());
+    }
+    manifest.encode();
+    makeSegment(0);
+    m_segments[0].setContentType(ndn::tlv::ContentType_Manifest);
+    m_segments[0].setContent(manifest);
+  }
+  NDN_LOG_DEBUG("SegmentedObject created " << total << " chunks for prefix " << m_versionedName
+                << (withManifest ? " with a manifest" : ""));
+
+  getSegment(0);
+}
+
+const Data&
+SegmentedObject::getSegment(size_t segmentNo) const
+{
+  BOOST_ASSERT(segmentNo < m_segments.size());
+  if (!m_isSigned[segmentNo]) {
+    if (m_segments[segmentNo].getName().empty()) {
+      makeSegment(segmentNo);
+    }
+    m_keyChain.sign(m_segments[segmentNo], m_signingInfo);
+    m_isSigned[segmentNo] = true;
+    m_nSigned++;
+    // the signed wire is held on top of the shared content
+    m_bytes += m_segments[segmentNo].wireEncode().size();
+  }
+  return m_segments[segmentNo];
+}
+
+void
+SegmentedObject::makeSegment(size_t segmentNo) const
+{
+  auto& data = m_segments[segmentNo];
+  data.setName(Name(m_versionedName).appendSegment(segmentNo));
+  data.setFreshnessPeriod(m_freshnessPeriod);
+  data.setFinalBlock(Name::Component::fromSegment(m_segments.size() - 1));
+  if (segmentNo < m_firstChunk) {
+    return;
+  }
+  size_t offset = (segmentNo - m_firstChunk) * m_maxSegmentSize;
+  if (offset < m_content.size()) {
+    auto copySize = std::min(m_maxSegmentSize, m_content.size() - offset);
+    data.setContent(make_span(m_content.data() + offset, copySize));
+    m_copiedBytes += copySize;
+  }
+}
+
+} // namespace cledger::util::segment
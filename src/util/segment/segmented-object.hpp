@@ -0,0 +1,115 @@
+#ifndef CLEDGER_UTIL_SEGMENT_SEGMENTED_OBJECT_HPP
+#define CLEDGER_UTIL_SEGMENT_SEGMENTED_OBJECT_HPP
+
+#include "util/segment/segment-common.hpp"
+
+namespace cledger::util::segment {
+
+/**
+ * @brief The segments of one block, named `versionedName/<segment number>`
+ *
+ * Only the first segment is signed up front. Any other segment is cut from the block,
+ * which is shared rather than copied, and signed the first time it is asked for; the
+ * signed copy is kept, so the cost before the first segment can go out does not grow
+ * with the number of segments. There is always at least one segment, even when the
+ * block is empty.
+ *
+ * In manifest mode, segment 0 holds no content but the implicit digests of all other
+ * segments, as a Manifest signed with the signing info, and the other segments carry
+ * the content with a DigestSha256 signature only. One signature then covers the whole
+ * object. The mode is skipped when the content fits in one segment, or when the
+ * manifest itself would not.
+ */
+class SegmentedObject : noncopyable
+{
+public:
+  struct Options
+  {
+    SigningInfo signingInfo;
+    time::milliseconds freshnessPeriod = 10_s;
+    size_t maxSegmentSize = 8000;
+    bool useManifest = false;
+  };
+
+public:
+  SegmentedObject(const Name& versionedName, const Block& block, KeyChain& keyChain,
+                  const Options& opts);
+
+  const Name&
+  getVersionedName() const
+  {
+    return m_versionedName;
+  }
+
+  size_t
+  size() const
+  {
+    return m_segments.size();
+  }
+
+  /**
+   * @brief Approximate memory held, as the content, the segment names and the
+   *        segments signed so far; it grows as getSegment() signs segments
+   */
+  size_t
+  getBytes() const
+  {
+    return m_bytes;
+  }
+
+  /**
+   * @brief The signed segment @p segmentNo, signing it on first use
+   * @pre segmentNo < size()
+   */
+  const Data&
+  getSegment(size_t segmentNo) const;
+
+  /**
+   * @brief Segments signed with the signing info so far, not counting DigestSha256 ones
+   */
+  size_t
+  getSignedCount() const
+  {
+    return m_nSigned;
+  }
+
+  /**
+   * @brief Bytes of the content copied into segments so far
+   */
+  size_t
+  getCopiedBytes() const
+  {
+    return m_copiedBytes;
+  }
+
+  bool
+  hasManifest() const
+  {
+    return m_segments.front().getContentType() == ndn::tlv::ContentType_Manifest;
+  }
+
+private:
+  void
+  makeSegment(size_t segmentNo) const;
+
+private:
+  Name m_versionedName;
+  KeyChain& m_keyChain;
+  SigningInfo m_signingInfo;
+  time::milliseconds m_freshnessPeriod;
+  size_t m_maxSegmentSize;
+  Block m_content;
+  // the segment holding the first chunk, 1 behind a manifest
+  size_t m_firstChunk = 0;
+  mutable size_t m_bytes = 0;
+
+  // made and signed in place as they are first served
+  mutable std::vector<Data> m_segments;
+  mutable std::vector<bool> m_isSigned;
+  mutable size_t m_nSigned = 0;
+  mutable size_t m_copiedBytes = 0;
+};
+
+} // namespace cledger::util::segment
+
+#endif // CLEDGER_UTIL_SEGMENT_SEGMENTED_OBJECT_HPP
@@ -0,0 +1,402 @@
+#include "util/sha256-batch.hpp"
+
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define CLEDGER_SHA256_X86
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+namespace cledger::util::sha256 {
+
+const size_t BLOCK_SIZE = 64;
+
+const uint32_t K[64] = {
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+  0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+  0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+  0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+  0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+  0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+const uint32_t H0[8] = {
+  0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+};
+
+/**
+ * @brief The padded blocks of one message, the full ones read in place.
+ */
+class PaddedMessage
+{
+public:
+  void
+  reset(span<const uint8_t> message)
+  {
+    m_data = message.data();
+    m_fullBlocks = message.size() / BLOCK_SIZE;
+    size_t rest = message.size() % BLOCK_SIZE;
+    // 0x80 and the 64-bit length must fit after the rest
+    size_t tailBlocks = rest + 9 <= BLOCK_SIZE ? 1 : 2;
+    std::memset(m_tail, 0, sizeof(m_tail));
+    std::memcpy(m_tail, m_data + m_fullBlocks * BLOCK_SIZE, rest);
+    m_tail[rest] = 0x80;
+    uint64_t bits = static_cast<uint64_t>(message.size()) * 8;
+    uint8_t* end = m_tail + tailBlocks * BLOCK_SIZE;
+    for (int i = 1; i <= 8; i++) {
+      end[-i] = static_cast<uint8_t>(bits >> (8 * (i - 1)));
+    }
+    m_blocks = m_fullBlocks + tailBlocks;
+    m_next = 0;
+  }
+
+  bool
+  done() const
+  {
+    return m_next == m_blocks;
+  }
+
+  const uint8_t*
+  nextBlock()
+  {
+    size_t i = m_next++;
+    return i < m_fullBlocks ? m_data + i * BLOCK_SIZE : m_tail + (i - m_fullBlocks) * BLOCK_SIZE;
+  }
+
+private:
+  const uint8_t* m_data = nullptr;
+  size_t m_fullBlocks = 0;
+  size_t m_blocks = 0;
+  size_t m_next = 0;
+  uint8_t m_tail[2 * BLOCK_SIZE];
+};
+
+static void
+storeDigest(const uint32_t state[8], Digest& digest)
+{
+  for (int i = 0; i < 8; i++) {
+    digest[4 * i] = static_cast<uint8_t>(state[i] >> 24);
+    digest[4 * i + 1] = static_cast<uint8_t>(state[i] >> 16);
+    digest[4 * i + 2] = static_cast<uint8_t>(state[i] >> 8);
+    digest[4 * i + 3] = static_cast<uint8_t>(state[i]);
+  }
+}
+
+static void
+hashPortable(span<const span<const uint8_t>> messages, std::vector<Digest>& digests)
+{
+  for (size_t i = 0; i < messages.size(); i++) {
+    auto hash = Sha256::computeDigest(messages[i]);
+    std::memcpy(digests[i].data(), hash->data(), digests[i].size());
+  }
+}
+
+#ifdef CLEDGER_SHA256_X86
+
+__attribute__((target("sha,sse4.1")))
+static void
+compressShaNi(uint32_t state[8], const uint8_t* block)
+{
+  const __m128i MASK = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+  // the rounds instructions want the state as ABEF and CDGH
+  __m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0])), 0xB1);
+  __m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4])), 0x1B);
+  __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+  state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+  const __m128i abefSave = state0;
+  const __m128i cdghSave = state1;
+
+  // the last four message words, W[i & 3] is overwritten once W[i] is known
+  __m128i w[4];
+  for (int i = 0; i < 16; i++) {
+    __m128i wi;
+    if (i < 4) {
+      wi = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16 * i)), MASK);
+    }
+    else {
+      wi = _mm_sha256msg1_epu32(w[i & 3], w[(i - 3) & 3]);
+      wi = _mm_add_epi32(wi, _mm_alignr_epi8(w[(i - 1) & 3], w[(i - 2) & 3], 4));
+      wi = _mm_sha256msg2_epu32(wi, w[(i - 1) & 3]);
+    }
+    w[i & 3] = wi;
+    __m128i msg = _mm_add_epi32(wi, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&K[4 * i])));
+    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+    state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0E));
+  }
+
+  state0 = _mm_add_epi32(state0, abefSave);
+  state1 = _mm_add_epi32(state1, cdghSave);
+  tmp = _mm_shuffle_epi32(state0, 0x1B);
+  state1 = _mm_shuffle_epi32(state1, 0xB1);
+  state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+  state1 = _mm_alignr_epi8(state1, tmp, 8);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), state0);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), state1);
+}
+
+static void
+hashShaNi(span<const span<const uint8_t>> messages, std::vector<Digest>& digests)
+{
+  PaddedMessage padded;
+  for (size_t i = 0; i < messages.size(); i++) {
+    uint32_t state[8];
+    std::memcpy(state, H0, sizeof(state));
+    padded.reset(messages[i]);
+    while (!padded.done()) {
+      compressShaNi(state, padded.nextBlock());
+    }
+    storeDigest(state, digests[i]);
+  }
+}
+
+const int LANES = 8;
+
+#define CLEDGER_ROTR(x, n) _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - (n)))
+
+__attribute__((target("avx2")))
+static inline __m256i
+loadWord(const uint8_t* const blocks[LANES], int t)
+{
+  uint32_t words[LANES];
+  for (int l = 0; l < LANES; l++) {
+    uint32_t word;
+    std::memcpy(&word, blocks[l] + 4 * t, 4);
+    words[l] = __builtin_bswap32(word);
+  }
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words));
+}
+
+/**
+ * @brief One block of each of the eight lanes; vector element l is lane l.
+ */
+__attribute__((target("avx2")))
+static void
+compressAvx2(__m256i state[8], const uint8_t* const blocks[LANES])
+{
+  __m256i w[64];
+  for (int t = 0; t < 16; t++) {
+    w[t] = loadWord(blocks, t);
+  }
+  for (int t = 16; t < 64; t++) {
+    __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(CLEDGER_ROTR(w[t - 15], 7), CLEDGER_ROTR(w[t - 15], 18)),
+                                  _mm256_srli_epi32(w[t - 15], 3));
+    __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(CLEDGER_ROTR(w[t - 2], 17), CLEDGER_ROTR(w[t - 2], 19)),
+                                  _mm256_srli_epi32(w[t - 2], 10));
+    w[t] = _mm256_add_epi32(_mm256_add_epi32(w[t - 16], s0), _mm256_add_epi32(w[t - 7], s1));
+  }
+
+  __m256i a = state[0], b = state[1], c = state[2], d = state[3];
+  __m256i e = state[4], f = state[5], g = state[6], h = state[7];
+  for (int t = 0; t < 64; t++) {
+    __m256i bigS1 = _mm256_xor_si256(_mm256_xor_si256(CLEDGER_ROTR(e, 6), CLEDGER_ROTR(e, 11)), CLEDGER_ROTR(e, 25));
+    __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+    __m256i t1 = _mm256_add_epi32(_mm256_add_epi32(h, bigS1),
+                                  _mm256_add_epi32(_mm256_add_epi32(ch, _mm256_set1_epi32(K[t])), w[t]));
+    __m256i bigS0 = _mm256_xor_si256(_mm256_xor_si256(CLEDGER_ROTR(a, 2), CLEDGER_ROTR(a, 13)), CLEDGER_ROTR(a, 22));
+    __m256i maj = _mm256_xor_si256(_mm256_and_si256(a, _mm256_xor_si256(b, c)), _mm256_and_si256(b, c));
+    __m256i t2 = _mm256_add_epi32(bigS0, maj);
+    h = g;
+    g = f;
+    f = e;
+    e = _mm256_add_epi32(d, t1);
+    d = c;
+    c = b;
+    b = a;
+    a = _mm256_add_epi32(t1, t2);
+  }
+  state[0] = _mm256_add_epi32(state[0], a);
+  state[1] = _mm256_add_epi32(state[1], b);
+  state[2] = _mm256_add_epi32(state[2], c);
+  state[3] = _mm256_add_epi32(state[3], d);
+  state[4] = _mm256_add_epi32(state[4], e);
+  state[5] = _mm256_add_epi32(state[5], f);
+  state[6] = _mm256_add_epi32(state[6], g);
+  state[7] = _mm256_add_epi32(state[7], h);
+}
+
+#undef CLEDGER_ROTR
+
+__attribute__((target("avx2")))
+static void
+hashAvx2(span<const span<const uint8_t>> messages, std::vector<Digest>& digests)
+{
+  static const uint8_t IDLE_BLOCK[BLOCK_SIZE] = {};
+  const size_t NONE = messages.size();
+
+  PaddedMessage padded[LANES];
+  size_t current[LANES];
+  size_t next = 0;
+  int busy = 0;
+  alignas(32) uint32_t lanes[8][LANES];
+  for (int l = 0; l < LANES; l++) {
+    current[l] = NONE;
+  }
+
+  __m256i state[8];
+  for (int k = 0; k < 8; k++) {
+    state[k] = _mm256_setzero_si256();
+  }
+  for (;;) {
+    // refill the lanes whose message is done
+    for (int k = 0; k < 8; k++) {
+      _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[k]), state[k]);
+    }
+    for (int l = 0; l < LANES; l++) {
+      if (current[l] != NONE && padded[l].done()) {
+        uint32_t words[8];
+        for (int k = 0; k < 8; k++) {
+          words[k] = lanes[k][l];
+        }
+        storeDigest(words, digests[current[l]]);
+        current[l] = NONE;
+        busy--;
+      }
+      if (current[l] == NONE && next < messages.size()) {
+        current[l] = next;
+        padded[l].reset(messages[next++]);
+        for (int k = 0; k < 8; k++) {
+          lanes[k][l] = H0[k];
+        }
+        busy++;
+      }
+    }
+    if (busy == 0) {
+      break;
+    }
+    for (int k = 0; k < 8; k++) {
+      state[k] = _mm256_load_si256(reinterpret_cast<const __m256i*>(lanes[k]));
+    }
+
+    // run the lanes until one of them finishes its message
+    for (;;) {
+      const uint8_t* blocks[LANES];
+      bool finished = false;
+      for (int l = 0; l < LANES; l++) {
+        blocks[l] = current[l] == NONE ? IDLE_BLOCK : padded[l].nextBlock();
+        finished = finished || (current[l] != NONE && padded[l].done());
+      }
+      compressAvx2(state, blocks);
+      if (finished) {
+        break;
+      }
+    }
+  }
+}
+
+static bool
+hasShaNi()
+{
+  unsigned int eax, ebx, ecx, edx;
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !(ecx & bit_SSE4_1)) {
+    return false;
+  }
+  if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+    return false;
+  }
+  return (ebx & (1u << 29)) != 0;
+}
+
+#endif // CLEDGER_SHA256_X86
+
+enum class Implementation {
+  PORTABLE,
+  SHA_NI,
+  AVX2,
+};
+
+static const char*
+toString(Implementation implementation)
+{
+  switch (implementation) {
+    case Implementation::SHA_NI:
+      return "sha-ni";
+    case Implementation::AVX2:
+      return "avx2";
+    default:
+      return "portable";
+  }
+}
+
+static std::vector<Implementation>
+listSupported()
+{
+  std::vector<Implementation> supported;
+#ifdef CLEDGER_SHA256_X86
+  if (hasShaNi()) {
+    supported.push_back(Implementation::SHA_NI);
+  }
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    supported.push_back(Implementation::AVX2);
+  }
+#endif
+  supported.push_back(Implementation::PORTABLE);
+  return supported;
+}
+
+// the first supported one is the fastest
+static Implementation
+getDetected()
+{
+  static const Implementation detected = listSupported().front();
+  return detected;
+}
+
+static std::vector<Digest>
+hashWith(Implementation implementation, span<const span<const uint8_t>> messages)
+{
+  std::vector<Digest> digests(messages.size());
+  switch (implementation) {
+#ifdef CLEDGER_SHA256_X86
+    case Implementation::SHA_NI:
+      hashShaNi(messages, digests);
+      break;
+    case Implementation::AVX2:
+      hashAvx2(messages, digests);
+      break;
+#endif
+    default:
+      hashPortable(messages, digests);
+      break;
+  }
+  return digests;
+}
+
+std::vector<Digest>
+hashMany(span<const span<const uint8_t>> messages)
+{
+  return hashWith(getDetected(), messages);
+}
+
+const char*
+getImplementation()
+{
+  return toString(getDetected());
+}
+
+std::vector<std::string>
+getSupportedImplementations()
+{
+  std::vector<std::string> ret;
+  for (auto i : listSupported()) {
+    ret.push_back(toString(i));
+  }
+  return ret;
+}
+
+std::vector<Digest>
+hashManyWith(const std::string& implementation, span<const span<const uint8_t>> messages)
+{
+  for (auto i : listSupported()) {
+    if (implementation == toString(i)) {
+      return hashWith(i, messages);
+    }
+  }
+  NDN_THROW(std::runtime_error("SHA-256 implementation " + implementation + " is not supported here"));
+}
+
+} // namespace cledger::util::sha256
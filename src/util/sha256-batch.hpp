@@ -0,0 +1,48 @@
+#ifndef CLEDGER_UTIL_SHA256_BATCH_HPP
+#define CLEDGER_UTIL_SHA256_BATCH_HPP
+
+#include "cledger-common.hpp"
+
+#include <array>
+
+namespace cledger::util::sha256 {
+
+using Digest = std::array<uint8_t, 32>;
+
+/**
+ * @brief SHA-256 of many independent messages at once.
+ *
+ * On x86 CPUs with the SHA extensions, each message goes through the SHA-NI rounds.
+ * Otherwise, with AVX2, eight messages are hashed side by side, one per 32-bit lane,
+ * and a lane picks up the next message as soon as its current one is done. Anything
+ * else falls back to Sha256::computeDigest for each message.
+ *
+ * @return the digests, in the order of @p messages
+ */
+std::vector<Digest>
+hashMany(span<const span<const uint8_t>> messages);
+
+/**
+ * @brief The implementation hashMany() picked for this CPU: "sha-ni", "avx2" or "portable".
+ */
+const char*
+getImplementation();
+
+/**
+ * @brief The implementations this CPU can run, named as by getImplementation().
+ *
+ * "portable" is always among them.
+ */
+std::vector<std::string>
+getSupportedImplementations();
+
+/**
+ * @brief hashMany() forced to run @p implementation, to check each one against the others.
+ * @throw std::runtime_error @p implementation is unknown or not supported by this CPU
+ */
+std::vector<Digest>
+hashManyWith(const std::string& implementation, span<const span<const uint8_t>> messages);
+
+} // namespace cledger::util::sha256
+
+#endif // CLEDGER_UTIL_SHA256_BATCH_HPP
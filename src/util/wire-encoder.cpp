@@ -0,0 +1,29 @@
+#include "util/wire-encoder.hpp"
+
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+
+namespace cledger::util {
+
+Block
+encodeWires(uint32_t type, span<const Block> elements)
+{
+  size_t valueLength = 0;
+  for (const auto& element : elements) {
+    BOOST_ASSERT(element.hasWire());
+    valueLength += element.size();
+  }
+  ndn::EncodingEstimator estimator;
+  size_t totalLength = valueLength + estimator.prependVarNumber(valueLength) + estimator.prependVarNumber(type);
+
+  // nothing is reserved in front, the estimate is the exact size
+  ndn::EncodingBuffer encoder(totalLength, 0);
+  for (size_t i = elements.size(); i > 0; i--) {
+    encoder.prependBytes(make_span(elements[i - 1].data(), elements[i - 1].size()));
+  }
+  encoder.prependVarNumber(valueLength);
+  encoder.prependVarNumber(type);
+  BOOST_ASSERT(encoder.size() == totalLength);
+  return encoder.block();
+}
+
+} // namespace cledger::util
@@ -0,0 +1,22 @@
+#ifndef CLEDGER_UTIL_WIRE_ENCODER_HPP
+#define CLEDGER_UTIL_WIRE_ENCODER_HPP
+
+#include "cledger-common.hpp"
+
+namespace cledger::util {
+
+/**
+ * @brief Encode a block of @p type whose elements are the wires of @p elements, as is.
+ *
+ * The total length is estimated first, so the wires are copied once into one buffer
+ * allocated at its final size, and the result shares that buffer. Unlike push_back()
+ * and Block::encode(), the elements are neither parsed nor kept as sub-blocks.
+ *
+ * @pre every element has a wire
+ */
+Block
+encodeWires(uint32_t type, span<const Block> elements);
+
+} // namespace cledger::util
+
+#endif // CLEDGER_UTIL_WIRE_ENCODER_HPP
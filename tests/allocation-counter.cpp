@@ -0,0 +1,48 @@
+#include "allocation-counter.hpp"
+
+#include <cstdlib>
+#include <new>
+
+namespace cledger::tests {
+
+// per thread, so that allocations of io or worker threads do not leak into a count
+static thread_local size_t nAllocations = 0;
+static thread_local size_t nBytes = 0;
+
+size_t
+getAllocationCount()
+{
+  return nAllocations;
+}
+
+size_t
+getAllocatedBytes()
+{
+  return nBytes;
+}
+
+} // namespace cledger::tests
+
+// the array and nothrow forms forward to this one
+void*
+operator new(std::size_t size)
+{
+  cledger::tests::nAllocations++;
+  cledger::tests::nBytes += size;
+  if (auto p = std::malloc(size == 0 ? 1 : size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void
+operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
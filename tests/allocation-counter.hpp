@@ -0,0 +1,25 @@
+#ifndef CLEDGER_TESTS_ALLOCATION_COUNTER_HPP
+#define CLEDGER_TESTS_ALLOCATION_COUNTER_HPP
+
+#include <cstddef>
+
+namespace cledger::tests {
+
+/**
+ * @brief Number of calls to the global operator new made so far by the calling thread.
+ *
+ * The unit tests replace the global operator new and delete to keep this count; take it
+ * before and after the code under test.
+ */
+size_t
+getAllocationCount();
+
+/**
+ * @brief Bytes asked from the global operator new so far by the calling thread.
+ */
+size_t
+getAllocatedBytes();
+
+} // namespace cledger::tests
+
+#endif // CLEDGER_TESTS_ALLOCATION_COUNTER_HPP
@@ -0,0 +1,91 @@
+#include "dag/interlock-policy-dispatch.hpp"
+#include "boost-test.hpp"
+#include "benchmarks/timed-execute.hpp"
+
+#include <iostream>
+
+namespace cledger::tests {
+
+using dag::EdgeState;
+using dag::policy::InterlockPolicy;
+
+BOOST_AUTO_TEST_SUITE(BenchmarkPolicyDispatch)
+
+const size_t N_STATES = 64;
+const size_t N_DESCENDANTS = 8;
+const size_t N_ROUNDS = 100000;
+
+static void
+compareDispatch(const std::string& policyType)
+{
+  std::vector<EdgeState> states(N_STATES);
+  for (size_t i = 0; i < states.size(); i++) {
+    states[i].stateName = dag::toStateName(Name("/ndn/ledger/ancestor").appendNumber(i));
+    for (size_t j = 0; j < N_DESCENDANTS; j++) {
+      Name recordName("/ndn/ledger");
+      recordName.append("producer" + std::to_string((i + j) % 5)).appendNumber(j);
+      states[i].descendants.insert(dag::toStateName(recordName));
+    }
+  }
+
+  auto policy = InterlockPolicy::createInterlockPolicy(policyType, "");
+  auto intf = policy->getInterface();
+  auto dispatch = dag::policy::makePolicyDispatch(*policy);
+
+  // what DagModule::evaluateWaitlist used to call for every ancestor
+  uint64_t functionSum = 0;
+  auto functionTime = timedExecute([&] {
+    for (size_t r = 0; r < N_ROUNDS; r++) {
+      for (auto& s : states) {
+        functionSum += intf.evaluater(s);
+      }
+    }
+  });
+
+  uint64_t virtualSum = 0;
+  auto virtualTime = timedExecute([&] {
+    for (size_t r = 0; r < N_ROUNDS; r++) {
+      for (auto& s : states) {
+        virtualSum += policy->evaluate(s);
+      }
+    }
+  });
+
+  // resolved once per record, then direct calls for every ancestor
+  uint64_t staticSum = 0;
+  auto staticTime = timedExecute([&] {
+    dag::policy::visitPolicy(dispatch, [&] (auto& p) {
+      for (size_t r = 0; r < N_ROUNDS; r++) {
+        for (auto& s : states) {
+          staticSum += p.evaluate(s);
+        }
+      }
+    });
+  });
+
+  BOOST_CHECK_EQUAL(functionSum, virtualSum);
+  BOOST_CHECK_EQUAL(functionSum, staticSum);
+
+  size_t nCalls = N_ROUNDS * N_STATES;
+  auto perCall = [nCalls] (time::nanoseconds d) {
+    return std::to_string(d.count() / static_cast<double>(nCalls)) + " ns/call";
+  };
+  std::cout << "Policy dispatch, " << policyType << ", " << nCalls << " evaluations\n"
+            << "  std::function: " << perCall(functionTime) << "\n"
+            << "  virtual:       " << perCall(virtualTime) << "\n"
+            << "  static:        " << perCall(staticTime) << std::endl;
+}
+
+BOOST_AUTO_TEST_CASE(Descendants)
+{
+  compareDispatch("policy-descendants");
+}
+
+BOOST_AUTO_TEST_CASE(Witness)
+{
+  compareDispatch("policy-witness");
+}
+
+BOOST_AUTO_TEST_SUITE_END() // BenchmarkPolicyDispatch
+
+} // namespace cledger::tests
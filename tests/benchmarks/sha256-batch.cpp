@@ -0,0 +1,76 @@
+#include "util/sha256-batch.hpp"
+#include "boost-test.hpp"
+#include "benchmarks/timed-execute.hpp"
+
+#include <cstring>
+#include <iostream>
+#include <random>
+
+namespace cledger::tests {
+
+BOOST_AUTO_TEST_SUITE(BenchmarkSha256Batch)
+
+const size_t N_MESSAGES = 4096;
+const size_t N_ROUNDS = 20;
+
+// payloads of one catch-up, hashed one by one as toMapName(payload) did, then in a batch
+static void
+compareHashing(size_t minSize, size_t maxSize)
+{
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<size_t> sizes(minSize, maxSize);
+  std::vector<Buffer> payloads;
+  for (size_t i = 0; i < N_MESSAGES; i++) {
+    Buffer payload(sizes(rng));
+    for (auto& b : payload) {
+      b = static_cast<uint8_t>(rng());
+    }
+    payloads.push_back(std::move(payload));
+  }
+  std::vector<span<const uint8_t>> messages(payloads.begin(), payloads.end());
+
+  std::vector<ndn::ConstBufferPtr> single;
+  auto singleTime = timedExecute([&] {
+    for (size_t r = 0; r < N_ROUNDS; r++) {
+      single.clear();
+      for (auto m : messages) {
+        single.push_back(Sha256::computeDigest(m));
+      }
+    }
+  });
+
+  std::vector<util::sha256::Digest> batch;
+  auto batchTime = timedExecute([&] {
+    for (size_t r = 0; r < N_ROUNDS; r++) {
+      batch = util::sha256::hashMany(messages);
+    }
+  });
+
+  BOOST_REQUIRE_EQUAL(single.size(), batch.size());
+  for (size_t i = 0; i < batch.size(); i++) {
+    BOOST_CHECK(std::memcmp(single[i]->data(), batch[i].data(), batch[i].size()) == 0);
+  }
+
+  size_t nHashes = N_ROUNDS * N_MESSAGES;
+  auto perHash = [nHashes] (time::nanoseconds d) {
+    return std::to_string(d.count() / static_cast<double>(nHashes)) + " ns/message";
+  };
+  std::cout << "SHA-256 of " << N_MESSAGES << " messages of " << minSize << "-" << maxSize << " bytes\n"
+            << "  Sha256::computeDigest: " << perHash(singleTime) << "\n"
+            << "  hashMany (" << util::sha256::getImplementation() << "): " << perHash(batchTime) << std::endl;
+}
+
+BOOST_AUTO_TEST_CASE(SmallPayloads)
+{
+  compareHashing(0, 256);
+}
+
+BOOST_AUTO_TEST_CASE(Certificates)
+{
+  // a certificate Data with an ECDSA or RSA signature
+  compareHashing(400, 2000);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // BenchmarkSha256Batch
+
+} // namespace cledger::tests
@@ -0,0 +1,20 @@
+#ifndef CLEDGER_TESTS_BENCHMARKS_TIMED_EXECUTE_HPP
+#define CLEDGER_TESTS_BENCHMARKS_TIMED_EXECUTE_HPP
+
+#include "cledger-common.hpp"
+
+namespace cledger::tests {
+
+template<typename F>
+time::nanoseconds
+timedExecute(const F& f)
+{
+  auto before = time::steady_clock::now();
+  f();
+  auto after = time::steady_clock::now();
+  return after - before;
+}
+
+} // namespace cledger::tests
+
+#endif // CLEDGER_TESTS_BENCHMARKS_TIMED_EXECUTE_HPP
@@ -0,0 +1,127 @@
+#include "dag/dag-module.hpp"
+#include "dag/tip-selector.hpp"
+#include "storage/ledger-storage.hpp"
+#include "boost-test.hpp"
+#include "benchmarks/timed-execute.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+
+namespace cledger::tests {
+
+using dag::DagModule;
+using dag::tip::TipSelector;
+
+BOOST_AUTO_TEST_SUITE(BenchmarkTipSelection)
+
+const size_t N_PRODUCERS = 16;
+const size_t N_BURSTS = 300;
+// records published concurrently from the same view of the tips
+const size_t BURST_SIZE = 12;
+const uint32_t THRESHOLD = 3;
+
+struct Report
+{
+  double avgPointers = 0;
+  size_t maxPointers = 0;
+  double avgLatency = 0;
+  size_t maxLatency = 0;
+  size_t interlocked = 0;
+  size_t records = 0;
+  time::nanoseconds elapsed;
+};
+
+// every burst, BURST_SIZE distinct producers point to the tips they currently see
+static Report
+simulate(const std::string& selectorType, size_t maxFanOut)
+{
+  auto storage = storage::LedgerStorage::createLedgerStorage("storage-memory", "/bench/ledger", "");
+  auto policy = dag::policy::InterlockPolicy::createInterlockPolicy("policy-witness", "");
+  DagModule dag(storage->getInterface(), policy->getInterface());
+  auto selector = TipSelector::createTipSelector(selectorType, maxFanOut);
+
+  std::mt19937 rng(0);
+  std::vector<uint64_t> seqs(N_PRODUCERS, 0);
+  std::map<Name, size_t> published;
+  size_t nPointers = 0;
+  size_t sumLatency = 0;
+  Report report;
+
+  auto producerName = [] (size_t p) { return Name("/ndn").append("producer" + std::to_string(p)); };
+
+  report.elapsed = timedExecute([&] {
+    Record genesis;
+    genesis.setName(producerName(0).appendNumber(++seqs[0]));
+    genesis.setType(tlv::GENESIS_RECORD);
+    genesis.addPointer(genesis.getName());
+    published[genesis.getName()] = 0;
+    dag.add(genesis);
+
+    std::vector<size_t> producers(N_PRODUCERS);
+    std::iota(producers.begin(), producers.end(), 0);
+    for (size_t b = 0; b < N_BURSTS; b++) {
+      auto tips = dag.getTips();
+      std::shuffle(producers.begin(), producers.end(), rng);
+      std::vector<Record> burst;
+      for (size_t i = 0; i < BURST_SIZE; i++) {
+        auto producer = producerName(producers[i]);
+        Record r;
+        r.setName(Name(producer).appendNumber(++seqs[producers[i]]));
+        r.setPointers(selector->select(tips, producer));
+        nPointers += r.getPointers().size();
+        report.maxPointers = std::max(report.maxPointers, r.getPointers().size());
+        burst.push_back(r);
+      }
+      for (auto& r : burst) {
+        size_t index = published.size();
+        published[r.getName()] = index;
+        dag.add(r);
+      }
+      for (auto& r : dag.harvestAbove(THRESHOLD, true)) {
+        size_t latency = published.size() - published[r.getName()];
+        sumLatency += latency;
+        report.maxLatency = std::max(report.maxLatency, latency);
+        report.interlocked++;
+      }
+    }
+  });
+
+  report.records = published.size();
+  report.avgPointers = double(nPointers) / (published.size() - 1);
+  report.avgLatency = report.interlocked ? double(sumLatency) / report.interlocked : 0;
+  return report;
+}
+
+static void
+print(const std::string& label, const Report& r)
+{
+  std::cout << "  " << std::left << std::setw(22) << label << std::right << std::fixed << std::setprecision(1)
+            << " pointers avg " << std::setw(6) << r.avgPointers << " max " << std::setw(4) << r.maxPointers
+            << " | latency avg " << std::setw(6) << r.avgLatency << " max " << std::setw(5) << r.maxLatency
+            << " records | interlocked " << r.interlocked << "/" << r.records
+            << " | " << time::duration_cast<time::milliseconds>(r.elapsed) << "\n";
+}
+
+BOOST_AUTO_TEST_CASE(Bursty)
+{
+  std::cout << "Tip selection, " << N_PRODUCERS << " producers, " << N_BURSTS << " bursts of "
+            << BURST_SIZE << " records, witness threshold " << THRESHOLD << "\n";
+
+  auto all = simulate("tips-all", 0);
+  auto allBounded = simulate("tips-all", 4);
+  auto interlock = simulate("tips-interlock", 4);
+  print("tips-all", all);
+  print("tips-all (4)", allBounded);
+  print("tips-interlock (4)", interlock);
+  std::cout << std::flush;
+
+  BOOST_CHECK_LE(allBounded.maxPointers, 4);
+  BOOST_CHECK_LE(interlock.maxPointers, 4);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // BenchmarkTipSelection
+
+} // namespace cledger::tests
@@ -0,0 +1,89 @@
+#include "dag/interlock-policy-witness.hpp"
+#include "boost-test.hpp"
+#include "benchmarks/timed-execute.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+
+namespace cledger::tests {
+
+using dag::EdgeState;
+using dag::policy::InterlockPolicyWitness;
+
+BOOST_AUTO_TEST_SUITE(BenchmarkWitnessPolicy)
+
+const size_t N_PRODUCERS = 300;
+const size_t N_RECORDS_PER_PRODUCER = 2;
+const size_t N_ANCESTORS = 4;
+
+// the pre-bitset evaluation: distinct data prefixes among all descendants
+static uint32_t
+evaluateBySet(const EdgeState& state)
+{
+  std::set<Name> witness;
+  for (auto& item : state.descendants) {
+    witness.insert(dag::fromStateName(item).getPrefix(-1));
+  }
+  return witness.size();
+}
+
+BOOST_AUTO_TEST_CASE(ManyProducers)
+{
+  // records from all producer ledgers, arriving interleaved
+  std::vector<Name> descendants;
+  for (size_t seq = 1; seq <= N_RECORDS_PER_PRODUCER; seq++) {
+    for (size_t p = 0; p < N_PRODUCERS; p++) {
+      Name recordName("/ndn/ledger");
+      recordName.append("producer" + std::to_string(p)).appendNumber(seq);
+      descendants.push_back(dag::toStateName(recordName));
+    }
+  }
+  std::shuffle(descendants.begin(), descendants.end(), std::mt19937(0));
+
+  std::vector<EdgeState> ancestors(N_ANCESTORS);
+  for (size_t i = 0; i < ancestors.size(); i++) {
+    ancestors[i].stateName = dag::toStateName(Name("/ndn/ledger/ancestor").appendNumber(i));
+  }
+
+  // same pattern as DagModule::evaluateAncestors: every new record becomes a
+  // descendant of each pending ancestor, which is then re-evaluated
+  auto setStates = ancestors;
+  uint64_t setSum = 0;
+  auto setTime = timedExecute([&] {
+    for (auto& d : descendants) {
+      for (auto& a : setStates) {
+        a.descendants.insert(d);
+        setSum += evaluateBySet(a);
+      }
+    }
+  });
+
+  InterlockPolicyWitness policy;
+  auto intf = policy.getInterface();
+  uint64_t bitsetSum = 0;
+  auto bitsetTime = timedExecute([&] {
+    for (auto& d : descendants) {
+      for (auto& a : ancestors) {
+        if (a.descendants.insert(d).second) {
+          intf.tracker(a, d);
+        }
+        bitsetSum += intf.evaluater(a);
+      }
+    }
+  });
+
+  BOOST_CHECK_EQUAL(setSum, bitsetSum);
+  for (auto& a : ancestors) {
+    BOOST_CHECK_EQUAL(intf.evaluater(a), N_PRODUCERS);
+  }
+
+  std::cout << "Witness policy, " << N_PRODUCERS << " producers, "
+            << descendants.size() << " descendants x " << N_ANCESTORS << " ancestors\n"
+            << "  set-based:  " << time::duration_cast<time::milliseconds>(setTime) << "\n"
+            << "  bitset:     " << time::duration_cast<time::milliseconds>(bitsetTime) << std::endl;
+}
+
+BOOST_AUTO_TEST_SUITE_END() // BenchmarkWitnessPolicy
+
+} // namespace cledger::tests
@@ -0,0 +1,45 @@
+#include "batch-query.hpp"
+#include "test-common.hpp"
+
+namespace cledger::tests {
+
+BOOST_AUTO_TEST_SUITE(TestBatchQuery)
+
+BOOST_AUTO_TEST_CASE(QueryEncodeDecode)
+{
+  BatchQuery query;
+  query.certNames = {"/ndn/site1/KEY/1/self/1", "/ndn/site2/KEY/2/self/1"};
+  query.withProof = true;
+  auto decoded = decodeBatchQuery(encodeBatchQuery(query));
+  BOOST_CHECK_EQUAL_COLLECTIONS(decoded.certNames.begin(), decoded.certNames.end(),
+                                query.certNames.begin(), query.certNames.end());
+  BOOST_CHECK(decoded.withProof);
+
+  query.withProof = false;
+  BOOST_CHECK(!decodeBatchQuery(encodeBatchQuery(query)).withProof);
+
+  // one over the limit
+  query.certNames.resize(BatchQuery::MAX_BATCH_SIZE + 1, Name("/ndn/site3/KEY/3/self/1"));
+  BOOST_CHECK_THROW(decodeBatchQuery(encodeBatchQuery(query)), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(ResponseEncodeDecode)
+{
+  std::vector<BatchAnswer> answers(2);
+  answers[0].certName = "/ndn/site1/KEY/1/self/1";
+  answers[0].content = ndn::makeStringBlock(ndn::tlv::Content, "records");
+  // denied
+  answers[1].certName = "/ndn/site2/KEY/2/self/1";
+
+  auto decoded = decodeBatchResponse(encodeBatchResponse(answers));
+  BOOST_REQUIRE_EQUAL(decoded.size(), 2);
+  BOOST_CHECK_EQUAL(decoded[0].certName, answers[0].certName);
+  BOOST_REQUIRE(decoded[0].content);
+  BOOST_CHECK_EQUAL(*decoded[0].content, *answers[0].content);
+  BOOST_CHECK_EQUAL(decoded[1].certName, answers[1].certName);
+  BOOST_CHECK(!decoded[1].content);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestBatchQuery
+
+} // namespace cledger::tests
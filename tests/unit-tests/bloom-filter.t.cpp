@@ -0,0 +1,54 @@
+#include "util/bloom-filter.hpp"
+#include "test-common.hpp"
+
+namespace cledger::tests {
+
+using util::BloomFilter;
+
+BOOST_AUTO_TEST_SUITE(TestBloomFilter)
+
+BOOST_AUTO_TEST_CASE(NoFalseNegatives)
+{
+  BloomFilter filter(1000, 0.01);
+  // about 9.6 bits and 7 hashes per entry
+  BOOST_CHECK_EQUAL(filter.getHashCount(), 7);
+  BOOST_CHECK_GE(filter.getBitCount(), 9000);
+
+  for (int i = 0; i < 1000; i++) {
+    filter.insert(Name("/ndn/site1/KEY").appendNumber(i).append("self").appendVersion(1));
+  }
+  for (int i = 0; i < 1000; i++) {
+    BOOST_CHECK(filter.mayContain(Name("/ndn/site1/KEY").appendNumber(i).append("self").appendVersion(1)));
+  }
+
+  int falsePositives = 0;
+  for (int i = 1000; i < 11000; i++) {
+    falsePositives += filter.mayContain(Name("/ndn/site1/KEY").appendNumber(i).append("self").appendVersion(1));
+  }
+  // 1% expected, with plenty of slack
+  BOOST_CHECK_LT(falsePositives, 300);
+}
+
+BOOST_AUTO_TEST_CASE(EncodeRestore)
+{
+  BloomFilter filter(1000, 0.01);
+  for (int i = 0; i < 100; i++) {
+    filter.insert(Name("/ndn/site1/KEY").appendNumber(i).append("self").appendVersion(1));
+  }
+  auto block = filter.encode();
+
+  BloomFilter restored(1000, 0.01);
+  restored.restore(block);
+  for (int i = 0; i < 200; i++) {
+    auto name = Name("/ndn/site1/KEY").appendNumber(i).append("self").appendVersion(1);
+    BOOST_CHECK_EQUAL(restored.mayContain(name), filter.mayContain(name));
+  }
+
+  // the bits only mean something to a filter of the same size
+  BloomFilter other(2000, 0.01);
+  BOOST_CHECK_THROW(other.restore(block), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestBloomFilter
+
+} // namespace cledger::tests
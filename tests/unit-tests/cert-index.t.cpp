@@ -0,0 +1,47 @@
+#include "dag/cert-index.hpp"
+#include "dag/payload-map.hpp"
+#include "test-common.hpp"
+
+#include <ndn-cxx/security/signing-helpers.hpp>
+
+namespace cledger::tests {
+
+BOOST_FIXTURE_TEST_SUITE(TestCertIndex, IdentityManagementFixture)
+
+BOOST_AUTO_TEST_CASE(Encoding)
+{
+  Data cert(Name("/ndn/site1/KEY/1234/self/v=1"));
+  m_keyChain.sign(cert, ndn::signingWithSha256());
+  dag::CertIndexEntry input;
+  input.certName = cert.getName();
+  input.digest = cert.getFullName().get(-1);
+  input.stateName = Name("/32=EdgeState/ndn/site1/instance1/1");
+  input.proof.emplace_back("/32=EdgeState/ndn/site1/instance2/1");
+  input.proof.emplace_back("/32=EdgeState/ndn/site1/instance3/1");
+
+  auto output = dag::decodeCertIndexEntry(dag::encodeCertIndexEntry(input));
+  BOOST_CHECK_EQUAL(output.certName, input.certName);
+  BOOST_CHECK_EQUAL(output.digest, input.digest);
+  BOOST_CHECK(output.digest.isImplicitSha256Digest());
+  BOOST_CHECK_EQUAL(Name(output.certName).append(output.digest), cert.getFullName());
+  BOOST_CHECK_EQUAL(output.stateName, input.stateName);
+  BOOST_CHECK_EQUAL_COLLECTIONS(output.proof.begin(), output.proof.end(),
+                                input.proof.begin(), input.proof.end());
+
+  BOOST_CHECK_EQUAL(dag::toCertIndexName(cert.getName()),
+                    Name(dag::certIndexNameHeader).append(cert.getName()));
+}
+
+BOOST_AUTO_TEST_CASE(MapNameFromDigest)
+{
+  Data cert(Name("/ndn/site1/KEY/1234/self/v=1"));
+  m_keyChain.sign(cert, ndn::signingWithSha256());
+  auto wire = cert.wireEncode();
+  // the PayloadMap of a Data is found from its implicit digest, without rehashing
+  BOOST_CHECK_EQUAL(dag::toMapName(cert.getFullName().get(-1)),
+                    dag::toMapName(make_span<const uint8_t>(wire.data(), wire.size())));
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestCertIndex
+
+} // namespace cledger::tests
@@ -1,8 +1,11 @@
 #include "dag/dag-module.hpp"
 #include "storage/ledger-memory.hpp"
 #include "dag/interlock-policy-descendants.hpp"
+#include "allocation-counter.hpp"
 #include "test-common.hpp"
 
+#include <numeric>
+
 namespace cledger::tests {
 
 using ndn::DummyClientFace;
@@ -172,6 +175,135 @@ BOOST_AUTO_TEST_CASE(Rectangular3)
   // }
 }
 
+BOOST_AUTO_TEST_CASE(OutOfOrder)
+{
+  /*
+   * r1 <-- r2 <-- r3 <-- r4, added in reverse order
+   */
+
+  Record r1, r2, r3, r4;
+  r1.setName(Name("/r1"));
+  r1.setType(tlv::GENESIS_RECORD);
+  r1.addPointer(r1.getName());
+
+  r2.setName(Name("/r2"));
+  r2.addPointer(r1.getName());
+
+  r3.setName(Name("/r3"));
+  r3.addPointer(r2.getName());
+
+  r4.setName(Name("/r4"));
+  r4.addPointer(r3.getName());
+
+  auto storage = storage::LedgerStorage::createLedgerStorage("storage-memory", "/test/ledger", "");
+  auto policy = dag::policy::InterlockPolicy::createInterlockPolicy("policy-descendants", "");
+  DagModule eManager(storage->getInterface(), policy->getInterface());
+  eManager.add(r4);
+  eManager.add(r3);
+  eManager.add(r2);
+
+  // missing parents are indexed in memory, not stored as placeholders
+  BOOST_CHECK_EQUAL(1, eManager.getPendingCount());
+  BOOST_CHECK_THROW(storage->getInterface().getter(dag::toStateName(r1.getName())), std::exception);
+
+  eManager.add(r1);
+  BOOST_CHECK_EQUAL(0, eManager.getPendingCount());
+  BOOST_CHECK_EQUAL(3, eManager.harvestAbove(1).size());
+  BOOST_CHECK_EQUAL(2, eManager.harvestAbove(2).size());
+  BOOST_CHECK_EQUAL(1, eManager.harvestAbove(3, true).size());
+  BOOST_CHECK_EQUAL(0, eManager.harvestAbove(3).size());
+}
+
+// counts what the per-round arena asks for beyond its first block
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+  size_t nAllocations = 0;
+
+private:
+  void*
+  do_allocate(size_t bytes, size_t alignment) override
+  {
+    nAllocations++;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  void
+  do_deallocate(void* p, size_t bytes, size_t alignment) override
+  {
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+
+  bool
+  do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+  {
+    return this == &other;
+  }
+};
+
+BOOST_AUTO_TEST_CASE(ArenaAllocations)
+{
+  /*
+   * r0 <-- r1 <-- ... <-- r63
+   */
+  std::vector<Record> records(64);
+  for (size_t i = 0; i < records.size(); i++) {
+    records[i].setName(Name("/r").appendNumber(i));
+    if (i == 0) {
+      records[i].setType(tlv::GENESIS_RECORD);
+      records[i].addPointer(records[i].getName());
+    }
+    else {
+      records[i].addPointer(records[i - 1].getName());
+    }
+  }
+
+  auto storage = storage::LedgerStorage::createLedgerStorage("storage-memory", "/test/ledger", "");
+  auto policy = dag::policy::InterlockPolicy::createInterlockPolicy("policy-descendants", "");
+  DagModule eManager(storage->getInterface(), *policy);
+  CountingResource upstream;
+  eManager.m_arenaUpstream = &upstream;
+
+  // harvesting as records arrive keeps a few pending ancestors per round,
+  // whose traversal fits in the arena's first block
+  size_t nInterlocked = 0;
+  std::vector<size_t> perRound;
+  for (auto& r : records) {
+    auto before = getAllocationCount();
+    eManager.add(r);
+    perRound.push_back(getAllocationCount() - before);
+    nInterlocked += eManager.harvestAbove(3, true).size();
+  }
+  BOOST_CHECK_EQUAL(nInterlocked, records.size() - 3);
+  BOOST_CHECK_EQUAL(upstream.nAllocations, 0);
+
+  // so the heap traffic of a round, as counted by the global operator new, does not
+  // grow with the chain; the slack covers amortized growth of the storage and interner
+  auto early = std::accumulate(perRound.begin() + 16, perRound.begin() + 32, size_t(0));
+  auto late = std::accumulate(perRound.begin() + 48, perRound.begin() + 64, size_t(0));
+  BOOST_TEST_MESSAGE("Allocations in rounds 16-31: " << early << ", in rounds 48-63: " << late);
+  BOOST_CHECK_GT(early, 0);
+  BOOST_CHECK_LE(late, early + 8);
+
+  // without harvesting, the arena grows geometrically with the number of ancestors
+  auto storage2 = storage::LedgerStorage::createLedgerStorage("storage-memory", "/test/ledger", "");
+  DagModule unharvested(storage2->getInterface(), *policy);
+  unharvested.m_arenaUpstream = &upstream;
+  size_t nAllocations = 0;
+  for (auto& r : records) {
+    auto before = getAllocationCount();
+    unharvested.add(r);
+    nAllocations += getAllocationCount() - before;
+  }
+  // every pending ancestor is still decoded and updated, but the traversal
+  // containers only cost the arena's spills on top of that
+  BOOST_CHECK_GT(nAllocations, late);
+  BOOST_CHECK_GT(upstream.nAllocations, 0);
+  BOOST_CHECK_LT(upstream.nAllocations, nAllocations / 4);
+  BOOST_CHECK_LE(upstream.nAllocations, 8 * records.size());
+  BOOST_CHECK_EQUAL(unharvested.harvestAbove(1).size(), records.size() - 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestDag
 
 } // namespace cledger::tests
@@ -0,0 +1,142 @@
+#include "dag/dag-journal.hpp"
+#include "dag/dag-module.hpp"
+#include "storage/ledger-memory.hpp"
+#include "test-common.hpp"
+
+namespace cledger::tests {
+
+using dag::DagJournal;
+using dag::DagModule;
+
+BOOST_FIXTURE_TEST_SUITE(TestDagJournal, IdentityManagementTimeFixture)
+
+BOOST_AUTO_TEST_CASE(ReplayAndCompact)
+{
+  auto storage = storage::LedgerStorage::createLedgerStorage("storage-memory", "/test/ledger", "");
+  DagJournal journal(storage->getInterface(), 8);
+  for (int i = 0; i < 20; i++) {
+    journal.enter(Name("/s").appendNumber(i));
+    if (i % 2 == 0) {
+      journal.leave(Name("/s").appendNumber(i));
+    }
+    journal.flush();
+  }
+  journal.wait(Name("/m1"), Name("/s/1"));
+  journal.wait(Name("/m1"), Name("/s/3"));
+  journal.wait(Name("/m2"), Name("/s/5"));
+  journal.resolve(Name("/m2"));
+  journal.flush();
+
+  DagJournal reader(storage->getInterface(), 8);
+  auto snapshot = reader.load();
+  BOOST_CHECK_EQUAL(snapshot.frontier.size(), 10);
+  BOOST_CHECK_EQUAL(snapshot.pending.size(), 1);
+  BOOST_CHECK_EQUAL(snapshot.pending[Name("/m1")].size(), 2);
+
+  // 34 entries for a live state of 12
+  BOOST_CHECK(reader.needsCompaction(12));
+  reader.compact(snapshot);
+  BOOST_CHECK(!reader.needsCompaction(12));
+  BOOST_CHECK_THROW(storage->getInterface().getter(Name(dag::journalNameHeader).appendNumber(0)),
+                    std::exception);
+
+  // appends continue after the compacted segments
+  reader.leave(Name("/s/1"));
+  reader.flush();
+  auto compacted = DagJournal(storage->getInterface()).load();
+  BOOST_CHECK_EQUAL(compacted.frontier.size(), 9);
+  BOOST_CHECK(compacted.pending == snapshot.pending);
+}
+
+BOOST_AUTO_TEST_CASE(ReplayUnfinishedCompaction)
+{
+  auto storage = storage::LedgerStorage::createLedgerStorage("storage-memory", "/test/ledger", "");
+  for (bool withCheckpoint : {false, true}) {
+    DagJournal journal(storage->getInterface(), 0);
+    journal.load();
+    if (withCheckpoint) {
+      journal.checkpoint(Name("/checkpoint/1"));
+    }
+    for (int i = 0; i < 10; i++) {
+      journal.enter(Name("/s").appendNumber(i));
+      if (i % 2 == 0) {
+        journal.leave(Name("/s").appendNumber(i));
+      }
+    }
+    journal.wait(Name("/m1"), Name("/s/1"));
+    journal.flush();
+
+    // crash after the snapshot segments: neither the head nor the deletes reach the storage
+    auto intf = storage->getInterface();
+    intf.replacer = [] (const Name&, const Block&) {};
+    intf.deleter = [] (const Name&) {};
+    DagJournal crashing(intf, 0);
+    auto live = crashing.load();
+    BOOST_CHECK_EQUAL(live.epoch.size(), 5);
+    crashing.compact(live);
+
+    auto replayed = DagJournal(storage->getInterface(), 0).load();
+    BOOST_CHECK(replayed.frontier == live.frontier);
+    BOOST_CHECK(replayed.pending == live.pending);
+    BOOST_CHECK_EQUAL_COLLECTIONS(replayed.epoch.begin(), replayed.epoch.end(),
+                                  live.epoch.begin(), live.epoch.end());
+    BOOST_CHECK_EQUAL(replayed.lastCheckpoint, live.lastCheckpoint);
+
+    // finish the compaction before the next round
+    DagJournal finishing(storage->getInterface(), 0);
+    finishing.compact(finishing.load());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(RestoreDag)
+{
+  /*
+   * r1 <-- r2 <-- r3, r5 --> r4 (missing)
+   */
+  Record r1, r2, r3, r4, r5;
+  r1.setName(Name("/r1"));
+  r1.setType(tlv::GENESIS_RECORD);
+  r1.addPointer(r1.getName());
+  r2.setName(Name("/r2"));
+  r2.addPointer(r1.getName());
+  r3.setName(Name("/r3"));
+  r3.addPointer(r2.getName());
+  r4.setName(Name("/r4"));
+  r4.addPointer(r3.getName());
+  r5.setName(Name("/r5"));
+  r5.addPointer(r4.getName());
+
+  auto storage = storage::LedgerStorage::createLedgerStorage("storage-memory", "/test/ledger", "");
+  auto policy = dag::policy::InterlockPolicy::createInterlockPolicy("policy-descendants", "");
+  std::map<const uint32_t, std::set<Name>> waitlist;
+  {
+    DagModule eManager(storage->getInterface(), policy->getInterface());
+    eManager.restore();
+    for (auto& r : {r1, r2, r3, r5}) {
+      eManager.add(r);
+    }
+    BOOST_CHECK_EQUAL(1, eManager.harvestAbove(2, true).size());
+    waitlist = eManager.getWaitList();
+  }
+
+  // restarted on the same storage
+  DagModule eManager(storage->getInterface(), policy->getInterface());
+  eManager.restore();
+  auto nonEmpty = [] (std::map<const uint32_t, std::set<Name>> w) {
+    for (auto it = w.begin(); it != w.end();) {
+      it = it->second.empty() ? w.erase(it) : std::next(it);
+    }
+    return w;
+  };
+  BOOST_CHECK(nonEmpty(waitlist) == nonEmpty(eManager.getWaitList()));
+  BOOST_CHECK_EQUAL(1, eManager.getPendingCount());
+
+  // the missing record resolves the one waiting on it
+  eManager.add(r4);
+  BOOST_CHECK_EQUAL(0, eManager.getPendingCount());
+  BOOST_CHECK_EQUAL(2, eManager.harvestAbove(2, true).size());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestDagJournal
+
+} // namespace cledger::tests
@@ -0,0 +1,215 @@
+#include "dag/dag-worker.hpp"
+#include "storage/ledger-memory.hpp"
+#include "util/mpsc-queue.hpp"
+#include "test-common.hpp"
+
+#include <boost/asio/executor_work_guard.hpp>
+
+namespace cledger::tests {
+
+using dag::DagModule;
+using dag::DagWorker;
+using util::MpscQueue;
+
+BOOST_FIXTURE_TEST_SUITE(TestDagWorker, IdentityManagementTimeFixture)
+
+BOOST_AUTO_TEST_CASE(QueueBounded)
+{
+  MpscQueue<int> queue(3);
+  BOOST_CHECK_EQUAL(queue.capacity(), 4);
+  for (int i = 0; i < 4; i++) {
+    BOOST_CHECK(queue.push(int(i)));
+  }
+  int item = 4;
+  BOOST_CHECK(!queue.push(std::move(item)));
+  BOOST_CHECK_EQUAL(item, 4);
+
+  for (int i = 0; i < 4; i++) {
+    BOOST_CHECK(queue.pop(item));
+    BOOST_CHECK_EQUAL(item, i);
+  }
+  BOOST_CHECK(queue.empty());
+  BOOST_CHECK(!queue.pop(item));
+}
+
+BOOST_AUTO_TEST_CASE(QueueMultiProducer)
+{
+  const int nProducers = 4;
+  const int nItems = 10000;
+  MpscQueue<std::pair<int, int>> queue(64);
+  std::vector<std::thread> producers;
+  for (int p = 0; p < nProducers; p++) {
+    producers.emplace_back([&queue, p] {
+      for (int i = 0; i < nItems; i++) {
+        while (!queue.push(std::make_pair(p, i))) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  // items of one producer come out in the order they were pushed
+  std::vector<int> next(nProducers, 0);
+  int received = 0;
+  std::pair<int, int> item;
+  while (received < nProducers * nItems) {
+    if (queue.pop(item)) {
+      BOOST_REQUIRE_EQUAL(item.second, next[item.first]++);
+      received++;
+    }
+  }
+  for (auto& t : producers) {
+    t.join();
+  }
+  BOOST_CHECK(queue.empty());
+}
+
+BOOST_AUTO_TEST_CASE(Threaded)
+{
+  /*
+   * r1 <-- r2 <-- r3 <-- r4
+   */
+  Record r1, r2, r3, r4;
+  r1.setName(Name("/r1"));
+  r1.setType(tlv::GENESIS_RECORD);
+  r1.addPointer(r1.getName());
+
+  r2.setName(Name("/r2"));
+  r2.addPointer(r1.getName());
+
+  r3.setName(Name("/r3"));
+  r3.addPointer(r2.getName());
+
+  r4.setName(Name("/r4"));
+  r4.addPointer(r3.getName());
+
+  auto storage = storage::LedgerStorage::createLedgerStorage("storage-memory", "/test/ledger", "");
+  auto policy = dag::policy::InterlockPolicy::createInterlockPolicy("policy-descendants", "");
+  DagModule eManager(storage->getInterface(), policy->getInterface());
+
+  boost::asio::io_context ioCtx;
+  auto guard = boost::asio::make_work_guard(ioCtx);
+  size_t nResults = 0;
+  size_t nInterlocked = 0;
+  {
+    // a capacity of 2 forces the overflow list to be used
+    DagWorker worker(ioCtx, eManager, 1, [&] (const DagWorker::Result& result) {
+      nResults++;
+      nInterlocked += result.interlocked.size();
+    }, true, 2);
+    for (auto& r : {r1, r2, r3, r4}) {
+      worker.submit(r);
+    }
+    for (int i = 0; i < 100 && nResults < 4; i++) {
+      ioCtx.run_one_for(std::chrono::milliseconds(50));
+    }
+  }
+  BOOST_CHECK_EQUAL(nResults, 4);
+  BOOST_CHECK_EQUAL(nInterlocked, 3);
+}
+
+static std::vector<Record>
+makeChain(size_t length)
+{
+  std::vector<Record> records(length);
+  for (size_t i = 0; i < length; i++) {
+    records[i].setName(Name("/r").appendNumber(i));
+    if (i == 0) {
+      records[i].setType(tlv::GENESIS_RECORD);
+      records[i].addPointer(records[i].getName());
+    }
+    else {
+      records[i].addPointer(records[i - 1].getName());
+    }
+  }
+  return records;
+}
+
+BOOST_AUTO_TEST_CASE(PostAfterRecords)
+{
+  auto records = makeChain(4);
+  auto storage = storage::LedgerStorage::createLedgerStorage("storage-memory", "/test/ledger", "");
+  auto policy = dag::policy::InterlockPolicy::createInterlockPolicy("policy-descendants", "");
+  DagModule eManager(storage->getInterface(), policy->getInterface());
+
+  boost::asio::io_context ioCtx;
+  auto guard = boost::asio::make_work_guard(ioCtx);
+  std::vector<Name> events;
+  std::vector<dag::EdgeState> tips;
+  optional<size_t> waiting;
+  {
+    DagWorker worker(ioCtx, eManager, 10, [&] (const DagWorker::Result& result) {
+      events.push_back(result.stateName);
+      tips = result.tips;
+    }, true, 2);
+    for (auto& r : records) {
+      worker.submit(r);
+    }
+    // runs after the records, and its result comes back on the io_context
+    worker.post([] (DagModule& dag) { return dag.getWaitList().size(); },
+                [&] (size_t size) { waiting = size; });
+    for (int i = 0; i < 100 && !waiting; i++) {
+      ioCtx.run_one_for(std::chrono::milliseconds(50));
+    }
+  }
+  BOOST_CHECK_EQUAL(events.size(), 4);
+  BOOST_REQUIRE(waiting);
+  // every record waits, under a threshold of 10
+  BOOST_CHECK_GT(*waiting, 0);
+  BOOST_REQUIRE_EQUAL(tips.size(), 1);
+  BOOST_CHECK_EQUAL(tips.front().stateName, dag::toStateName(records.back().getName()));
+}
+
+BOOST_AUTO_TEST_CASE(DrainOnShutdown)
+{
+  auto records = makeChain(8);
+  auto storage = storage::LedgerStorage::createLedgerStorage("storage-memory", "/test/ledger", "");
+  auto policy = dag::policy::InterlockPolicy::createInterlockPolicy("policy-descendants", "");
+  DagModule eManager(storage->getInterface(), policy->getInterface());
+
+  boost::asio::io_context ioCtx;
+  {
+    // most records are still held when the worker goes away
+    DagWorker worker(ioCtx, eManager, 10, [] (auto&&) {}, true, 2);
+    for (auto& r : records) {
+      worker.submit(r);
+    }
+  }
+  for (auto& r : records) {
+    BOOST_CHECK(eManager.find(dag::toStateName(r.getName())));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(DrainDeliversResults)
+{
+  auto records = makeChain(8);
+  auto storage = storage::LedgerStorage::createLedgerStorage("storage-memory", "/test/ledger", "");
+  auto policy = dag::policy::InterlockPolicy::createInterlockPolicy("policy-descendants", "");
+  DagModule eManager(storage->getInterface(), policy->getInterface());
+
+  boost::asio::io_context ioCtx;
+  std::vector<Name> events;
+  size_t nInterlocked = 0;
+  DagWorker worker(ioCtx, eManager, 1, [&] (const DagWorker::Result& result) {
+    events.push_back(result.stateName);
+    nInterlocked += result.interlocked.size();
+  }, true, 2);
+  for (auto& r : records) {
+    worker.submit(r);
+  }
+  // the io_context never runs, drain() delivers every result in order
+  worker.drain();
+  BOOST_REQUIRE_EQUAL(events.size(), records.size());
+  for (size_t i = 0; i < records.size(); i++) {
+    BOOST_CHECK_EQUAL(events[i], dag::toStateName(records[i].getName()));
+  }
+  BOOST_CHECK_EQUAL(nInterlocked, records.size() - 1);
+
+  // nothing left for the handlers posted meanwhile
+  ioCtx.poll();
+  BOOST_CHECK_EQUAL(events.size(), records.size());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestDagWorker
+
+} // namespace cledger::tests
@@ -1,4 +1,6 @@
 #include "dag/edge-state-list.hpp"
+#include "dag/state-tracker.hpp"
+#include "storage/ledger-memory.hpp"
 #include "test-common.hpp"
 
 namespace cledger::tests {
@@ -15,7 +17,7 @@ BOOST_AUTO_TEST_CASE(Encoding)
   EdgeStateList input;
   input.listName = Name("/32=EdgeStateList/l1");
   input.key = 1;
-  input.value.insert(Name("/32=EdgeState/r1"));
+  input.value.push_back(Name("/32=EdgeState/r1"));
   input.nextList = getStateListNull();
 
   Block block = encodeEdgeStateList(input);
@@ -25,6 +27,100 @@ BOOST_AUTO_TEST_CASE(Encoding)
   BOOST_CHECK_EQUAL(input.nextList, output.nextList);
 }
 
+BOOST_AUTO_TEST_CASE(PagedTracker)
+{
+  auto storage = storage::LedgerStorage::createLedgerStorage("storage-memory", "/test/ledger", "");
+  auto intf = storage->getInterface();
+  // writes to storage, to check that adds are batched
+  size_t writes = 0;
+  auto adder = intf.adder;
+  intf.adder = [&writes, adder] (const Name& name, const Block& block) {
+    writes++;
+    adder(name, block);
+  };
+  auto interner = std::make_shared<dag::NameInterner>(intf);
+
+  const size_t nStates = 100;
+  {
+    dag::StateTracker tracker(intf, interner, 8);
+    for (size_t i = 0; i < nStates; i++) {
+      BOOST_CHECK(tracker.add(dag::toStateName(Name("/r").appendNumber(i))));
+    }
+    BOOST_CHECK(!tracker.add(dag::toStateName(Name("/r").appendNumber(7))));
+    BOOST_CHECK_EQUAL(tracker.size(), nStates);
+    BOOST_CHECK_EQUAL(tracker.getPageCount(), 13);
+    BOOST_CHECK_EQUAL(writes, 0);
+
+    // the whole batch is a single journal segment
+    BOOST_CHECK(tracker.hasUncommitted());
+    tracker.commit();
+    BOOST_CHECK(!tracker.hasUncommitted());
+    BOOST_CHECK_EQUAL(writes, 1);
+
+    // pages are served from memory
+    auto page = decodeEdgeStateList(tracker.getPage(dag::StateTracker::toPageName(12)));
+    BOOST_CHECK_EQUAL(page.value.size(), 4);
+    BOOST_CHECK_EQUAL(page.nextList, getStateListNull());
+    BOOST_CHECK_THROW(tracker.getPage(dag::StateTracker::toPageName(13)), std::runtime_error);
+    BOOST_CHECK_THROW(tracker.getPage("/32=EdgeStateList/other"), std::runtime_error);
+  }
+
+  // restarted before any flush, the journal is replayed
+  {
+    dag::StateTracker replayed(intf, interner, 8);
+    BOOST_CHECK_EQUAL(replayed.size(), nStates);
+    BOOST_CHECK_EQUAL(replayed.getPageCount(), 13);
+    replayed.flush();
+    BOOST_CHECK_THROW(intf.getter(Name(dag::trackerJournalNameHeader).appendNumber(0)), std::exception);
+    // lost on restart, it was never committed
+    replayed.add(dag::toStateName(Name("/r").appendNumber(nStates)));
+  }
+
+  // the chain from page 0 holds every state once
+  std::set<Name> chained;
+  Name pageName = dag::StateTracker::toPageName(0);
+  BOOST_CHECK_EQUAL(pageName, dag::toStateListName(dag::globalTracker));
+  while (pageName != getStateListNull()) {
+    auto block = intf.getter(pageName);
+    auto page = decodeEdgeStateList(block);
+    BOOST_CHECK_LE(page.value.size(), 8);
+    chained.insert(page.value.begin(), page.value.end());
+    pageName = page.nextList;
+  }
+  BOOST_CHECK_EQUAL(chained.size(), nStates);
+
+  // reopened, appends go to the tail page
+  dag::StateTracker reopened(intf, interner, 8);
+  BOOST_CHECK_EQUAL(reopened.size(), nStates);
+  BOOST_CHECK(reopened.contains(dag::toStateName(Name("/r").appendNumber(42))));
+  BOOST_CHECK(reopened.add(dag::toStateName(Name("/r").appendNumber(nStates))));
+  BOOST_CHECK_EQUAL(reopened.getPageCount(), 13);
+}
+
+BOOST_AUTO_TEST_CASE(TrackerOrder)
+{
+  auto storage = storage::LedgerStorage::createLedgerStorage("storage-memory", "/test/ledger", "");
+  auto interner = std::make_shared<dag::NameInterner>(storage->getInterface());
+  // added against the Name order
+  std::vector<Name> added;
+  for (int i = 9; i >= 0; i--) {
+    added.push_back(dag::toStateName(Name("/r").appendNumber(i)));
+  }
+  {
+    dag::StateTracker tracker(storage->getInterface(), interner, 4);
+    for (const auto& s : added) {
+      tracker.add(s);
+    }
+    tracker.flush();
+  }
+
+  // the stored pages keep the order the states were added in
+  dag::StateTracker reopened(storage->getInterface(), interner, 4);
+  std::vector<Name> visited;
+  reopened.forEach([&visited] (const Name& s) { visited.push_back(s); });
+  BOOST_CHECK_EQUAL_COLLECTIONS(visited.begin(), visited.end(), added.begin(), added.end());
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestEdgeStateList
 
 } // namespace cledger::tests
\ No newline at end of file
@@ -0,0 +1,119 @@
+#include "dag/dag-module.hpp"
+#include "dag/epoch-checkpoint.hpp"
+#include "storage/ledger-memory.hpp"
+#include "util/merkle.hpp"
+#include "test-common.hpp"
+
+#include <ndn-cxx/util/string-helper.hpp>
+
+namespace cledger::tests {
+
+using dag::DagModule;
+using dag::EdgeState;
+
+BOOST_FIXTURE_TEST_SUITE(TestEpochCheckpoint, IdentityManagementTimeFixture)
+
+BOOST_AUTO_TEST_CASE(MerkleRoot)
+{
+  // RFC 6962 test vectors from the Certificate Transparency reference implementation
+  std::vector<std::vector<uint8_t>> inputs{
+    {}, {0x00}, {0x10}, {0x20, 0x21}, {0x30, 0x31}, {0x40, 0x41, 0x42, 0x43},
+    {0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57},
+    {0x60, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x6b, 0x6c, 0x6d, 0x6e, 0x6f},
+  };
+  std::vector<std::string> roots{
+    "6e340b9cffb37a989ca544e6bb780a2c78901d3fb33738768511a30617afa01d",
+    "fac54203e7cc696cf0dfcb42c92a1d9dbaf70ad9e621f4bd8d98662f00e3c125",
+    "aeb6bcfe274b70a14fb067a5e5578264db0fa9b51af5e0ba159158f329e06e77",
+    "d37ee418976dd95753c1c73862b9398fa2a2cf9b4ff0fdfe8b30cd95209614b7",
+    "4e3bbb1f7b478dcfe71fb631631519a3bca12c9aefca1612bfce4c13a86264d4",
+    "76e67dadbcdf1e10e1b74ddc608abd2f98dfb16fbce75277b5232a127f2087ef",
+    "ddb89be403809e325750d3d263cd78929c2942b7942a34b77e122c9594a74c8c",
+    "5dc9da79a70659a9ad559cb701ded9a2ab9d823aad2f4960cfe370eff4604328",
+  };
+  std::vector<ndn::ConstBufferPtr> leaves;
+  for (size_t i = 0; i < inputs.size(); i++) {
+    leaves.push_back(util::merkle::hashLeaf(inputs[i]));
+    BOOST_CHECK_EQUAL(ndn::toHex(*util::merkle::computeRoot(leaves), false), roots[i]);
+  }
+  BOOST_CHECK_EQUAL(ndn::toHex(*util::merkle::computeRoot({}), false),
+                    "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+}
+
+BOOST_AUTO_TEST_CASE(EncodeDecode)
+{
+  dag::EpochCheckpoint checkpoint;
+  checkpoint.epoch = 3;
+  checkpoint.checkpointName = dag::toCheckpointName(checkpoint.epoch);
+  checkpoint.records = {Name("/r1"), Name("/r2")};
+  checkpoint.size = checkpoint.records.size();
+  checkpoint.root = dag::computeCheckpointRoot(checkpoint.records);
+
+  auto decoded = dag::decodeEpochCheckpoint(dag::encodeEpochCheckpoint(checkpoint));
+  BOOST_CHECK_EQUAL(decoded.checkpointName, checkpoint.checkpointName);
+  BOOST_CHECK_EQUAL(dag::fromCheckpointName(decoded.checkpointName), 3);
+  BOOST_CHECK_EQUAL(decoded.epoch, 3);
+  BOOST_CHECK_EQUAL(decoded.size, 2);
+  BOOST_CHECK(decoded.root == checkpoint.root);
+  BOOST_CHECK(decoded.records == checkpoint.records);
+}
+
+BOOST_AUTO_TEST_CASE(Checkpoint)
+{
+  /*
+   * r1 <-- r2 <-- r3 <-- r4 <-- r5, then r6 --> r5
+   */
+  std::vector<Record> records(6);
+  for (size_t i = 0; i < records.size(); i++) {
+    records[i].setName(Name("/r").appendNumber(i + 1));
+    if (i == 0) {
+      records[i].setType(tlv::GENESIS_RECORD);
+      records[i].addPointer(records[i].getName());
+    }
+    else {
+      records[i].addPointer(records[i - 1].getName());
+    }
+  }
+
+  auto storage = storage::LedgerStorage::createLedgerStorage("storage-memory", "/test/ledger", "");
+  auto policy = dag::policy::InterlockPolicy::createInterlockPolicy("policy-descendants", "");
+  DagModule eManager(storage->getInterface(), policy->getInterface());
+  BOOST_CHECK(!eManager.checkpoint(1));
+  for (size_t i = 0; i < 5; i++) {
+    eManager.add(records[i]);
+  }
+  BOOST_CHECK_EQUAL(4, eManager.harvestAbove(1, true).size());
+  BOOST_CHECK_EQUAL(4, eManager.getEpochSize());
+
+  auto checkpoint = eManager.checkpoint(1);
+  BOOST_REQUIRE(checkpoint);
+  BOOST_CHECK_EQUAL(checkpoint->epoch, 1);
+  BOOST_CHECK_EQUAL(checkpoint->size, 4);
+  BOOST_CHECK_EQUAL(0, eManager.getEpochSize());
+  auto stored = dag::decodeEpochCheckpoint(storage->getInterface().getter(checkpoint->checkpointName));
+  BOOST_CHECK(stored.root == dag::computeCheckpointRoot(stored.records));
+  BOOST_CHECK(stored.records == checkpoint->records);
+
+  // only the proof descendants are kept
+  auto r1 = eManager.getOrConstruct(dag::toStateName(records[0].getName()));
+  BOOST_CHECK_EQUAL(r1.status, EdgeState::CHECKPOINTED);
+  BOOST_CHECK_EQUAL(r1.descendants.size(), 1);
+
+  // traversal stops at the checkpoint boundary
+  eManager.add(records[5]);
+  r1 = eManager.getOrConstruct(dag::toStateName(records[0].getName()));
+  BOOST_CHECK_EQUAL(r1.descendants.size(), 1);
+  BOOST_CHECK_EQUAL(1, eManager.harvestAbove(1, true).size());
+
+  // a restart resumes the epoch numbering
+  DagModule restarted(storage->getInterface(), policy->getInterface());
+  restarted.restore();
+  BOOST_CHECK_EQUAL(1, restarted.getEpochSize());
+  auto next = restarted.checkpoint(1);
+  BOOST_REQUIRE(next);
+  BOOST_CHECK_EQUAL(next->epoch, 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestEpochCheckpoint
+
+} // namespace cledger::tests
@@ -0,0 +1,148 @@
+#include "dag/dag-module.hpp"
+#include "dag/interlock-engine.hpp"
+#include "storage/ledger-memory.hpp"
+#include "test-common.hpp"
+
+#include <random>
+
+namespace cledger::tests {
+
+using dag::DagModule;
+using dag::EdgeState;
+using dag::policy::InterlockEngine;
+
+BOOST_FIXTURE_TEST_SUITE(TestInterlockEngine, IdentityManagementTimeFixture)
+
+// random DAG in topological order: every record points to 1-3 earlier records
+static std::vector<Record>
+makeRandomDag(std::mt19937& rng, size_t nRecords, size_t nProducers)
+{
+  std::vector<Record> records;
+  std::vector<uint64_t> seqs(nProducers, 0);
+  for (size_t i = 0; i < nRecords; i++) {
+    size_t producer = rng() % nProducers;
+    Record r;
+    r.setName(Name("/ndn").append("producer" + std::to_string(producer)).appendNumber(++seqs[producer]));
+    if (records.empty()) {
+      r.setType(tlv::GENESIS_RECORD);
+      r.addPointer(r.getName());
+    }
+    else {
+      size_t nPointers = 1 + rng() % 3;
+      for (size_t k = 0; k < nPointers; k++) {
+        r.addPointer(records[rng() % records.size()].getName());
+      }
+    }
+    records.push_back(r);
+  }
+  return records;
+}
+
+static std::map<const uint32_t, std::set<Name>>
+nonEmpty(std::map<const uint32_t, std::set<Name>> waitlist)
+{
+  for (auto it = waitlist.begin(); it != waitlist.end();) {
+    it = it->second.empty() ? waitlist.erase(it) : std::next(it);
+  }
+  return waitlist;
+}
+
+static void
+checkEquivalence(const std::string& policyType)
+{
+  std::mt19937 rng(42);
+  for (int round = 0; round < 5; round++) {
+    auto storage = storage::LedgerStorage::createLedgerStorage("storage-memory", "/test/ledger", "");
+    auto policy = dag::policy::InterlockPolicy::createInterlockPolicy(policyType, "");
+    InterlockEngine engine(policyType);
+    DagModule eManager(storage->getInterface(), engine.getInterface(policy->getInterface()));
+
+    auto records = makeRandomDag(rng, 40 + rng() % 40, 2 + rng() % 6);
+    std::vector<EdgeState> window;
+    for (auto& r : records) {
+      eManager.add(r);
+    }
+    for (auto& r : records) {
+      window.push_back(eManager.getOrConstruct(dag::toStateName(r.getName())));
+    }
+
+    auto scores = engine.evaluate(window);
+    BOOST_REQUIRE_EQUAL(scores.size(), window.size());
+    for (auto& state : window) {
+      BOOST_CHECK_EQUAL(scores[state.stateName], policy->evaluate(state));
+    }
+
+    // no pass yet under the default window, one pass scores every pending state
+    eManager.evaluateWindow();
+    for (auto& [score, names] : eManager.getWaitList()) {
+      for (auto& name : names) {
+        BOOST_CHECK_EQUAL(score, policy->evaluate(eManager.getOrConstruct(name)));
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(DescendantsEquivalence)
+{
+  checkEquivalence("policy-descendants");
+}
+
+BOOST_AUTO_TEST_CASE(WitnessEquivalence)
+{
+  checkEquivalence("policy-witness");
+}
+
+BOOST_AUTO_TEST_CASE(BoundedWindow)
+{
+  std::mt19937 rng(7);
+  auto records = makeRandomDag(rng, 60, 4);
+  for (const auto& policyType : {"policy-descendants", "policy-witness"}) {
+    // the per-record evaluations made by each module
+    auto countEvaluations = [] (dag::policy::Interface intf, size_t& count) {
+      intf.evaluater = [evaluater = intf.evaluater, &count] (const EdgeState& state) {
+        count++;
+        return evaluater(state);
+      };
+      return intf;
+    };
+
+    auto policy = dag::policy::InterlockPolicy::createInterlockPolicy(policyType, "");
+    auto storage = storage::LedgerStorage::createLedgerStorage("storage-memory", "/test/ledger", "");
+    size_t nPerRecord = 0;
+    DagModule perRecord(storage->getInterface(), countEvaluations(policy->getInterface(), nPerRecord));
+
+    auto batchPolicy = dag::policy::InterlockPolicy::createInterlockPolicy(policyType, "");
+    auto batchStorage = storage::LedgerStorage::createLedgerStorage("storage-memory", "/test/ledger", "");
+    InterlockEngine engine(policyType);
+    size_t nBatch = 0;
+    DagModule batch(batchStorage->getInterface(), countEvaluations(batchPolicy->getInterface(), nBatch));
+    // scored every 8 records, the states touched since and their descendants only
+    size_t nPasses = 0;
+    batch.setBatchEvaluater([&engine, &nPasses] (const auto& window) {
+                              nPasses++;
+                              return engine.evaluate(window);
+                            }, 8);
+
+    for (size_t i = 0; i < records.size(); i++) {
+      perRecord.add(records[i]);
+      batch.add(records[i]);
+      // the same scores, once a pass has run
+      if ((i + 1) % 8 == 0) {
+        BOOST_CHECK(nonEmpty(perRecord.getWaitList()) == nonEmpty(batch.getWaitList()));
+      }
+    }
+    // the batch passes replace the per-record evaluations, they do not add to them
+    BOOST_CHECK_GT(nPerRecord, records.size());
+    BOOST_CHECK_EQUAL(nBatch, 0);
+    BOOST_CHECK_EQUAL(nPasses, records.size() / 8);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(UnsupportedPolicy)
+{
+  BOOST_CHECK_THROW(InterlockEngine("policy-unknown"), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestInterlockEngine
+
+} // namespace cledger::tests
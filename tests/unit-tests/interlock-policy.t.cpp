@@ -0,0 +1,138 @@
+#include "dag/dag-module.hpp"
+#include "dag/interlock-policy-dispatch.hpp"
+#include "storage/ledger-memory.hpp"
+#include "test-common.hpp"
+
+namespace cledger::tests {
+
+using dag::DagModule;
+using dag::EdgeState;
+using dag::policy::InterlockPolicyWitness;
+
+BOOST_FIXTURE_TEST_SUITE(TestInterlockPolicy, IdentityManagementTimeFixture)
+
+BOOST_AUTO_TEST_CASE(WitnessIncremental)
+{
+  /*
+   * a/1 <-- b/1 <-- b/2 <-- c/1
+   */
+  Record r1, r2, r3, r4;
+  r1.setName(Name("/a/1"));
+  r1.setType(tlv::GENESIS_RECORD);
+  r1.addPointer(r1.getName());
+
+  r2.setName(Name("/b/1"));
+  r2.addPointer(r1.getName());
+
+  r3.setName(Name("/b/2"));
+  r3.addPointer(r2.getName());
+
+  r4.setName(Name("/c/1"));
+  r4.addPointer(r3.getName());
+
+  auto storage = storage::LedgerStorage::createLedgerStorage("storage-memory", "/test/ledger", "");
+  auto policy = dag::policy::InterlockPolicy::createInterlockPolicy("policy-witness", "");
+  DagModule eManager(storage->getInterface(), policy->getInterface());
+  eManager.add(r1);
+  eManager.add(r2);
+  eManager.add(r3);
+  eManager.add(r4);
+
+  // incremental counts agree with the witness selection
+  for (auto& r : {r1, r2, r3, r4}) {
+    auto state = eManager.getOrConstruct(dag::toStateName(r.getName()));
+    BOOST_CHECK_EQUAL(policy->evaluate(state), policy->select(state).size());
+  }
+
+  // a fresh policy instance rebuilds its cache from the stored descendants
+  InterlockPolicyWitness coldPolicy;
+  auto state = eManager.getOrConstruct(dag::toStateName(r1.getName()));
+  BOOST_CHECK_EQUAL(coldPolicy.evaluate(state), 2);
+
+  BOOST_CHECK_EQUAL(2, eManager.harvestAbove(2).size());
+  BOOST_CHECK_EQUAL(3, eManager.harvestAbove(1).size());
+}
+
+BOOST_AUTO_TEST_CASE(WitnessRelease)
+{
+  InterlockPolicyWitness policy;
+  EdgeState state;
+  state.stateName = dag::toStateName(Name("/a/1"));
+  state.descendants.insert(dag::toStateName(Name("/b/1")));
+  BOOST_CHECK_EQUAL(policy.evaluate(state), 1);
+
+  auto descendant = dag::toStateName(Name("/c/1"));
+  state.descendants.insert(descendant);
+  policy.track(state, descendant);
+  BOOST_CHECK_EQUAL(policy.evaluate(state), 2);
+
+  policy.release(state.stateName);
+  BOOST_CHECK(policy.m_entries.empty());
+}
+
+BOOST_AUTO_TEST_CASE(WitnessSharesDagIds)
+{
+  Record r1, r2;
+  r1.setName(Name("/a/1"));
+  r1.setType(tlv::GENESIS_RECORD);
+  r1.addPointer(r1.getName());
+  r2.setName(Name("/b/1"));
+  r2.addPointer(r1.getName());
+
+  auto storage = storage::LedgerStorage::createLedgerStorage("storage-memory", "/test/ledger", "");
+  InterlockPolicyWitness policy;
+  DagModule eManager(storage->getInterface(), policy);
+  eManager.add(r1);
+  eManager.add(r2);
+
+  // the cache of the ancestor is keyed by the ID the DAG gave it
+  auto id = eManager.getInterner()->find(dag::toStateName(r1.getName()));
+  BOOST_REQUIRE(id);
+  BOOST_REQUIRE_EQUAL(policy.m_entries.count(*id), 1);
+  BOOST_CHECK_EQUAL(policy.m_entries.at(*id).producers.count(), 1);
+  BOOST_CHECK(policy.m_interner == eManager.getInterner());
+}
+
+BOOST_AUTO_TEST_CASE(StaticDispatch)
+{
+  /*
+   * a/1 <-- b/1 <-- a/2
+   *     \-- c/1
+   */
+  Record r1, r2, r3, r4;
+  r1.setName(Name("/a/1"));
+  r1.setType(tlv::GENESIS_RECORD);
+  r1.addPointer(r1.getName());
+
+  r2.setName(Name("/b/1"));
+  r2.addPointer(r1.getName());
+
+  r3.setName(Name("/a/2"));
+  r3.addPointer(r2.getName());
+
+  r4.setName(Name("/c/1"));
+  r4.addPointer(r1.getName());
+
+  for (auto type : {"policy-descendants", "policy-witness"}) {
+    auto policy = dag::policy::InterlockPolicy::createInterlockPolicy(type, "");
+    auto dispatch = dag::policy::makePolicyDispatch(*policy);
+    BOOST_CHECK(!std::holds_alternative<dag::policy::DynamicPolicy>(dispatch));
+
+    // the specialized engine ends up in the same state as the one going through the Interface
+    auto dynamicStorage = storage::LedgerStorage::createLedgerStorage("storage-memory", "/test/ledger", "");
+    auto dynamicPolicy = dag::policy::InterlockPolicy::createInterlockPolicy(type, "");
+    DagModule dynamicDag(dynamicStorage->getInterface(), dynamicPolicy->getInterface());
+    auto staticStorage = storage::LedgerStorage::createLedgerStorage("storage-memory", "/test/ledger", "");
+    DagModule staticDag(staticStorage->getInterface(), *policy);
+    for (auto& r : {r1, r2, r3, r4}) {
+      dynamicDag.add(r);
+      staticDag.add(r);
+    }
+    BOOST_CHECK(dynamicDag.getWaitList() == staticDag.getWaitList());
+    BOOST_CHECK_EQUAL(dynamicDag.harvestAbove(2).size(), staticDag.harvestAbove(2).size());
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestInterlockPolicy
+
+} // namespace cledger::tests
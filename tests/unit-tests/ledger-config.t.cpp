@@ -17,11 +17,19 @@ BOOST_AUTO_TEST_CASE(LedgerConfigFile)
   BOOST_CHECK_EQUAL(config.recordZones.front(), Name("/ndn/site1"));
   BOOST_CHECK_EQUAL(config.recordZones.back(), Name("/ndn/site2"));
   BOOST_CHECK_EQUAL(config.storageType, "storage-memory");
+  BOOST_CHECK_EQUAL(config.trackerFlushPeriod, time::seconds(10));
   BOOST_CHECK_EQUAL(config.policyType, "policy-descendants");
   BOOST_CHECK_EQUAL(config.policyThreshold, 3);
+  BOOST_CHECK_EQUAL(config.tipSelectorType, "tips-all");
+  BOOST_CHECK_EQUAL(config.maxFanOut, 0);
+  BOOST_CHECK_EQUAL(config.batchWindow, 0);
   BOOST_CHECK_EQUAL(config.interestSigner.getSignerType(), ndn::security::SigningInfo::SignerType::SIGNER_TYPE_HMAC);
   BOOST_CHECK_EQUAL(config.maxSegmentSize, 2000);
   BOOST_CHECK_EQUAL(config.sessionLength, ndn::time::seconds(60));
+  BOOST_CHECK_EQUAL(config.sessionMemoryBudget, 64 * 1024 * 1024);
+  BOOST_CHECK_EQUAL(config.segmentManifest, false);
+  BOOST_CHECK_EQUAL(config.nackCacheSize, 1024);
+  BOOST_CHECK_EQUAL(config.certFilterCapacity, 1000000);
 }
 
 BOOST_AUTO_TEST_CASE(LedgerConfigFileWithErrors)
@@ -1,4 +1,5 @@
 #include "storage/ledger-leveldb.hpp"
+#include "storage/ledger-memory.hpp"
 #include "test-common.hpp"
 
 namespace cledger::tests {
@@ -23,10 +24,56 @@ BOOST_AUTO_TEST_CASE(LevelDBWorkflow)
   BOOST_CHECK_NO_THROW(res = storage.getBlock(data.getName()));
   BOOST_CHECK_EQUAL(data.wireEncode(), res);
 
+  // replace operation
+  Data other(Name("/ndn/site1"));
+  other.setContent(ndn::makeStringBlock(ndn::tlv::Content, "other"));
+  m_keyChain.sign(other, info);
+  BOOST_CHECK_THROW(storage.addBlock(data.getName(), other.wireEncode()), std::runtime_error);
+  BOOST_CHECK_NO_THROW(storage.replaceBlock(data.getName(), other.wireEncode()));
+  BOOST_CHECK_EQUAL(storage.getBlock(data.getName()), other.wireEncode());
+
   // delete operation
   BOOST_CHECK_NO_THROW(storage.deleteBlock(data.getName()));
 }
 
+static void
+checkForEachName(LedgerStorage& storage)
+{
+  auto block = ndn::makeStringBlock(ndn::tlv::Content, "value");
+  for (const auto& name : {"/ndn/list", "/ndn/list/a", "/ndn/list/b/1", "/ndn/listing", "/ndn/other"}) {
+    storage.addBlock(name, block);
+  }
+
+  std::set<Name> names;
+  storage.forEachName("/ndn/list", [&names] (const Name& name) { names.insert(name); });
+  BOOST_CHECK_EQUAL(names.size(), 2);
+  BOOST_CHECK_EQUAL(names.count("/ndn/list/a"), 1);
+  BOOST_CHECK_EQUAL(names.count("/ndn/list/b/1"), 1);
+
+  // the visitor may read the storage back
+  size_t nVisited = 0;
+  storage.forEachName("/ndn/list", [&] (const Name& name) {
+    BOOST_CHECK_EQUAL(storage.getBlock(name), block);
+    nVisited++;
+  });
+  BOOST_CHECK_EQUAL(nVisited, 2);
+
+  for (const auto& name : {"/ndn/list", "/ndn/list/a", "/ndn/list/b/1", "/ndn/listing", "/ndn/other"}) {
+    storage.deleteBlock(name);
+  }
+  nVisited = 0;
+  storage.forEachName("/ndn/list", [&] (const Name&) { nVisited++; });
+  BOOST_CHECK_EQUAL(nVisited, 0);
+}
+
+BOOST_AUTO_TEST_CASE(ForEachName)
+{
+  LedgerLevelDB leveldb(Name("/ndn/ledger1"), ".test_db");
+  checkForEachName(leveldb);
+  LedgerMemory memory(Name("/ndn/ledger1"));
+  checkForEachName(memory);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestDBStorage
 
 } // namespace cledger::tests
\ No newline at end of file
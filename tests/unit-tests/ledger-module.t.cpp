@@ -1,7 +1,16 @@
 #include "ledger-module.hpp"
+#include "batch-query.hpp"
+#include "checker.hpp"
+#include "nack.hpp"
+#include "dag/cert-index.hpp"
+#include "dag/edge-state.hpp"
+#include "storage/ledger-leveldb.hpp"
 #include "svs-core-identity-time-fixture.hpp"
 #include "test-common.hpp"
 
+#include <boost/filesystem.hpp>
+#include <ndn-cxx/security/validator-null.hpp>
+
 namespace cledger::tests {
 
 using ndn::DummyClientFace;
@@ -99,6 +108,236 @@ BOOST_AUTO_TEST_CASE(Merged)
   ledger1.afterValidation(clientId6.getDefaultKey().getDefaultCertificate());
 }
 
+BOOST_AUTO_TEST_CASE(StoredData)
+{
+  auto anchorId = addIdentity(Name("/ndn/site1"));
+  addSubCertificate(Name("/ndn/site1/instance1"), anchorId);
+
+  DummyClientFace face(io, m_keyChain, {true, true});
+  LedgerModule ledger(face, m_keyChain, "tests/unit-tests/config-files/config-ledger-1");
+  advanceClocks(time::milliseconds(20), 10);
+
+  Data stored(Name("/ndn/site1/instance2/stored"));
+  stored.setContent(std::vector<uint8_t>(100, 0xAB));
+  m_keyChain.sign(stored, ndn::signingWithSha256());
+  ledger.getLedgerStorage()->addBlock(stored.getName(), stored.wireEncode());
+  // other objects share the storage under names a query may ask for
+  Name other("/ndn/site1/instance2/other");
+  ledger.getLedgerStorage()->addBlock(other, ndn::makeStringBlock(ndn::tlv::Content, "other"));
+
+  // an exact-name query gets the stored Data as it was stored
+  Interest query(stored.getName());
+  query.setForwardingHint({Name("/ndn/site1")});
+  face.sentData.clear();
+  face.receive(query);
+  advanceClocks(time::milliseconds(20), 5);
+  BOOST_REQUIRE(!face.sentData.empty());
+  BOOST_CHECK_EQUAL(face.sentData.back().wireEncode(), stored.wireEncode());
+
+  // anything else stored is not served, it gets a Nack
+  query.setName(other);
+  face.sentData.clear();
+  face.receive(query);
+  advanceClocks(time::milliseconds(20), 5);
+  BOOST_REQUIRE(!face.sentData.empty());
+  BOOST_CHECK_EQUAL(face.sentData.back().getContentType(), ndn::tlv::ContentType_Nack);
+  BOOST_CHECK(Nack::isValidName(face.sentData.back().getName()));
+  BOOST_CHECK_EQUAL(face.sentData.back().getName().getPrefix(Nack::NACK_OFFSET), other);
+}
+
+BOOST_AUTO_TEST_CASE(CertFilterAfterCrash)
+{
+  auto anchorId = addIdentity(Name("/ndn/site1"));
+  auto cert1 = addSubCertificate(Name("/ndn/site1/instance1"), anchorId).getDefaultKey().getDefaultCertificate();
+  auto cert2 = addSubCertificate(Name("/ndn/site1/instance2"), anchorId).getDefaultKey().getDefaultCertificate();
+  auto cert3 = addSubCertificate(Name("/ndn/site1/instance3"), anchorId).getDefaultKey().getDefaultCertificate();
+  boost::filesystem::remove_all(".test_ledger_db");
+
+  {
+    DummyClientFace face(io, m_keyChain, {true, true});
+    LedgerModule ledger(face, m_keyChain, "tests/unit-tests/config-files/config-ledger-3");
+    advanceClocks(time::milliseconds(20), 10);
+
+    // stored before the crash, submitted again after it
+    ledger.getLedgerStorage()->addBlock(cert1.getName(), cert1.wireEncode());
+    BOOST_CHECK(!ledger.mayKnowCert(cert1.getName()));
+    ledger.afterValidation(cert1);
+    BOOST_CHECK(ledger.mayKnowCert(cert1.getName()));
+
+    // indexed before the crash, its record not tracked yet
+    dag::CertIndexEntry entry;
+    entry.certName = cert2.getName();
+    entry.digest = cert2.getFullName().get(-1);
+    entry.stateName = dag::toStateName(Name("/ndn/site1/instance2/1"));
+    ledger.getLedgerStorage()->addBlock(dag::toCertIndexName(cert2.getName()), dag::encodeCertIndexEntry(entry));
+  }
+  {
+    // a crash saves no snapshot
+    storage::LedgerLevelDB storage(Name("/ndn/site1"), ".test_ledger_db");
+    storage.deleteBlock(dag::statusSnapshotName);
+    storage.deleteBlock(dag::certFilterName);
+  }
+
+  DummyClientFace face(io, m_keyChain, {true, true});
+  LedgerModule ledger(face, m_keyChain, "tests/unit-tests/config-files/config-ledger-3");
+  BOOST_CHECK(ledger.mayKnowCert(cert2.getName()));
+  // the filter is still used
+  BOOST_CHECK(!ledger.mayKnowCert(cert3.getName()));
+}
+
+BOOST_AUTO_TEST_CASE(IndexesAfterRestart)
+{
+  auto anchorId = addIdentity(Name("/ndn/site1"));
+  auto cert1 = addSubCertificate(Name("/ndn/site1/instance1"), anchorId).getDefaultKey().getDefaultCertificate();
+  auto cert2 = addSubCertificate(Name("/ndn/site1/instance2"), anchorId).getDefaultKey().getDefaultCertificate();
+  auto cert3 = addSubCertificate(Name("/ndn/site1/instance3"), anchorId).getDefaultKey().getDefaultCertificate();
+  boost::filesystem::remove_all(".test_ledger_db");
+
+  dag::LedgerStatus before;
+  {
+    DummyClientFace face(io, m_keyChain, {true, true});
+    LedgerModule ledger(face, m_keyChain, "tests/unit-tests/config-files/config-ledger-3");
+    advanceClocks(time::milliseconds(20), 10);
+    ledger.afterValidation(cert1);
+    ledger.afterValidation(cert2);
+    advanceClocks(time::milliseconds(20), 10);
+    before = ledger.m_statusIndex->getStatus();
+    BOOST_CHECK_EQUAL(before.pending + before.interlocked, 2);
+  }
+
+  DummyClientFace face(io, m_keyChain, {true, true});
+  LedgerModule ledger(face, m_keyChain, "tests/unit-tests/config-files/config-ledger-3");
+  // read from the snapshots, which are gone until the next shutdown
+  BOOST_CHECK_THROW(ledger.getLedgerStorage()->getBlock(dag::statusSnapshotName), std::runtime_error);
+  BOOST_CHECK_THROW(ledger.getLedgerStorage()->getBlock(dag::certFilterName), std::runtime_error);
+  auto after = ledger.m_statusIndex->getStatus();
+  BOOST_CHECK_EQUAL(after.pending, before.pending);
+  BOOST_CHECK_EQUAL(after.interlocked, before.interlocked);
+  BOOST_CHECK_EQUAL(after.oldestPending, before.oldestPending);
+  BOOST_CHECK(ledger.mayKnowCert(cert1.getName()));
+  BOOST_CHECK(ledger.mayKnowCert(cert2.getName()));
+  BOOST_CHECK(!ledger.mayKnowCert(cert3.getName()));
+}
+
+BOOST_AUTO_TEST_CASE(ProofsAfterShutdown)
+{
+  auto anchorId = addIdentity(Name("/ndn/site1"));
+  addSubCertificate(Name("/ndn/site1/instance1"), anchorId);
+  std::vector<Data> certs;
+  for (size_t i = 0; i < 8; i++) {
+    Data cert(Name("/ndn/site1/user").appendNumber(i).append("KEY").append("k").append("self").appendVersion(1));
+    cert.setContent(std::vector<uint8_t>(100, static_cast<uint8_t>(i)));
+    m_keyChain.sign(cert, ndn::signingWithSha256());
+    certs.push_back(cert);
+  }
+  boost::filesystem::remove_all(".test_ledger_db");
+
+  {
+    DummyClientFace face(io, m_keyChain, {true, true});
+    LedgerModule ledger(face, m_keyChain, "tests/unit-tests/config-files/config-ledger-4");
+    advanceClocks(time::milliseconds(20), 10);
+    // the worker thread gets them all, but none of its results is delivered before shutdown
+    for (const auto& cert : certs) {
+      ledger.afterValidation(cert);
+    }
+  }
+
+  DummyClientFace face(io, m_keyChain, {true, true});
+  LedgerModule ledger(face, m_keyChain, "tests/unit-tests/config-files/config-ledger-4");
+  size_t nInterlocked = 0;
+  for (const auto& cert : certs) {
+    auto entry = ledger.getCertIndex(cert.getName());
+    auto block = ledger.getLedgerStorage()->getBlock(entry.stateName);
+    if (dag::decodeEdgeState(block).status != dag::EdgeState::INTERLOCKED) {
+      continue;
+    }
+    nInterlocked++;
+    BOOST_CHECK(!entry.proof.empty());
+    BOOST_CHECK(ledger.makeProofContent(cert.getName()));
+  }
+  BOOST_CHECK_GT(nInterlocked, 0);
+}
+
+BOOST_AUTO_TEST_CASE(CheckpointNotIndexed)
+{
+  auto anchorId = addIdentity(Name("/ndn/site1"));
+  addSubCertificate(Name("/ndn/site1/instance1"), anchorId);
+
+  DummyClientFace face(io, m_keyChain, {true, true});
+  LedgerModule ledger(face, m_keyChain, "tests/unit-tests/config-files/config-ledger-5");
+  advanceClocks(time::milliseconds(20), 10);
+  for (size_t i = 0; i < 10; i++) {
+    Data cert(Name("/ndn/site1/user").appendNumber(i).append("KEY").append("k").append("self").appendVersion(1));
+    cert.setContent(std::vector<uint8_t>(100, static_cast<uint8_t>(i)));
+    m_keyChain.sign(cert, ndn::signingWithSha256());
+    ledger.afterValidation(cert);
+    advanceClocks(time::milliseconds(20), 5);
+  }
+
+  // a checkpoint was published, but it is no certificate
+  Name checkpointName = Name("/ndn/site1/instance1/CHECKPOINT").appendNumber(1);
+  BOOST_REQUIRE_NO_THROW(ledger.getLedgerStorage()->getBlock(checkpointName));
+  BOOST_CHECK_THROW(ledger.getLedgerStorage()->getBlock(dag::toCertIndexName(checkpointName)), std::runtime_error);
+  BOOST_CHECK(!ledger.mayKnowCert(checkpointName));
+}
+
+BOOST_AUTO_TEST_CASE(CheckManyInBatches)
+{
+  auto anchorId = addIdentity(Name("/ndn/site1"));
+  addSubCertificate(Name("/ndn/site1/instance1"), anchorId);
+
+  DummyClientFace ledgerFace(io, m_keyChain, {true, true});
+  LedgerModule ledger(ledgerFace, m_keyChain, "tests/unit-tests/config-files/config-ledger-1");
+  advanceClocks(time::milliseconds(20), 10);
+
+  // more than a batch, three in five of them in the ledger
+  std::vector<Data> certs;
+  std::set<Name> known;
+  for (size_t i = 0; i < BatchQuery::MAX_BATCH_SIZE + 8; i++) {
+    Data cert(Name("/ndn/site1/user").appendNumber(i).append("KEY").append("k").append("self").appendVersion(1));
+    cert.setContent(std::vector<uint8_t>(200, static_cast<uint8_t>(i)));
+    m_keyChain.sign(cert, ndn::signingWithSha256());
+    if (i % 5 < 3) {
+      ledger.afterValidation(cert);
+      known.insert(cert.getName());
+    }
+    certs.push_back(cert);
+  }
+  advanceClocks(time::milliseconds(20), 10);
+
+  DummyClientFace checkerFace(io, m_keyChain);
+  ndn::security::ValidatorNull validator;
+  checker::Checker client(checkerFace, validator);
+  std::set<Name> succeeded;
+  std::set<Name> failed;
+  client.doCheckMany(Name("/ndn/site1/LEDGER"), certs,
+    [&] (const Data& cert, const Block&) { succeeded.insert(cert.getName()); },
+    [&] (const Data& cert, const Error&) { failed.insert(cert.getName()); });
+
+  // both batches and their segments, fetched at the same time and without a hint
+  for (int i = 0; i < 100 && succeeded.size() + failed.size() < certs.size(); i++) {
+    auto interests = std::move(checkerFace.sentInterests);
+    checkerFace.sentInterests.clear();
+    for (const auto& interest : interests) {
+      BOOST_CHECK(interest.getForwardingHint().empty());
+      ledgerFace.receive(interest);
+    }
+    advanceClocks(time::milliseconds(1));
+    auto data = std::move(ledgerFace.sentData);
+    ledgerFace.sentData.clear();
+    for (const auto& d : data) {
+      checkerFace.receive(d);
+    }
+    advanceClocks(time::milliseconds(1));
+  }
+  BOOST_CHECK_EQUAL(succeeded.size(), known.size());
+  BOOST_CHECK(succeeded == known);
+  BOOST_CHECK_EQUAL(failed.size(), certs.size() - known.size());
+  for (const auto& name : failed) {
+    BOOST_CHECK_EQUAL(known.count(name), 0);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestLedgerModule
 
 } // namespace cledger::tests
@@ -0,0 +1,101 @@
+#include "dag/merkle-log.hpp"
+#include "inclusion-proof.hpp"
+#include "storage/ledger-memory.hpp"
+#include "util/merkle.hpp"
+#include "test-common.hpp"
+
+namespace cledger::tests {
+
+using dag::MerkleLog;
+
+BOOST_AUTO_TEST_SUITE(TestMerkleLog)
+
+static Block
+makeLeaf(size_t i)
+{
+  return Name("/ndn/producer").appendNumber(i).wireEncode();
+}
+
+BOOST_AUTO_TEST_CASE(RootAndProofs)
+{
+  auto storage = storage::LedgerStorage::createLedgerStorage("storage-memory", "/test/ledger", "");
+  MerkleLog log(storage->getInterface());
+  BOOST_CHECK_EQUAL(log.size(), 0);
+  BOOST_CHECK(log.root() == *util::merkle::computeRoot({}));
+
+  std::vector<ndn::ConstBufferPtr> leaves;
+  for (size_t n = 1; n <= 33; n++) {
+    auto leaf = makeLeaf(n - 1);
+    BOOST_CHECK_EQUAL(log.append(leaf), n - 1);
+    leaves.push_back(util::merkle::hashLeaf(leaf));
+
+    auto root = log.root();
+    BOOST_REQUIRE(root == *util::merkle::computeRoot(leaves));
+    for (uint64_t i = 0; i < n; i++) {
+      auto path = log.prove(i);
+      BOOST_CHECK(util::merkle::verifyInclusion(*leaves[i], i, n, path, root));
+      if (n > 1) {
+        // a proof does not hold for another leaf or another tree size
+        BOOST_CHECK(!util::merkle::verifyInclusion(*leaves[(i + 1) % n], i, n, path, root));
+        BOOST_CHECK(!util::merkle::verifyInclusion(*leaves[i], i, n + 1, path, root));
+      }
+    }
+  }
+
+  // a tampered path is rejected
+  auto path = log.prove(5);
+  path.front()[0] ^= 0x01;
+  BOOST_CHECK(!util::merkle::verifyInclusion(*leaves[5], 5, log.size(), path, log.root()));
+}
+
+BOOST_AUTO_TEST_CASE(AppendAndReopen)
+{
+  auto storage = storage::LedgerStorage::createLedgerStorage("storage-memory", "/test/ledger", "");
+  Buffer root;
+  {
+    MerkleLog log(storage->getInterface());
+    for (size_t i = 0; i < 21; i++) {
+      log.append(makeLeaf(i));
+    }
+    // appending a leaf twice keeps its index
+    BOOST_CHECK_EQUAL(log.append(makeLeaf(7)), 7);
+    BOOST_CHECK_EQUAL(log.size(), 21);
+    BOOST_CHECK_EQUAL(*log.find(makeLeaf(20)), 20);
+    BOOST_CHECK(!log.find(makeLeaf(21)));
+    root = log.root();
+  }
+
+  MerkleLog reopened(storage->getInterface());
+  BOOST_CHECK_EQUAL(reopened.size(), 21);
+  BOOST_CHECK(reopened.root() == root);
+  BOOST_CHECK_EQUAL(reopened.append(makeLeaf(21)), 21);
+  BOOST_CHECK(reopened.root() != root);
+}
+
+BOOST_AUTO_TEST_CASE(EncodeDecode)
+{
+  TreeHead treeHead;
+  treeHead.treeSize = 5;
+  treeHead.root = *util::merkle::computeRoot({util::merkle::hashLeaf(makeLeaf(0))});
+  auto decodedHead = decodeTreeHead(encodeTreeHead(treeHead));
+  BOOST_CHECK_EQUAL(decodedHead.treeSize, 5);
+  BOOST_CHECK(decodedHead.root == treeHead.root);
+
+  auto storage = storage::LedgerStorage::createLedgerStorage("storage-memory", "/test/ledger", "");
+  MerkleLog log(storage->getInterface());
+  for (size_t i = 0; i < 5; i++) {
+    log.append(makeLeaf(i));
+  }
+  InclusionProof proof;
+  proof.leafIndex = 3;
+  proof.treeSize = log.size();
+  proof.path = log.prove(proof.leafIndex);
+  auto decoded = decodeInclusionProof(encodeInclusionProof(proof));
+  BOOST_CHECK_EQUAL(decoded.leafIndex, 3);
+  BOOST_CHECK_EQUAL(decoded.treeSize, 5);
+  BOOST_CHECK(decoded.path == proof.path);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestMerkleLog
+
+} // namespace cledger::tests
@@ -0,0 +1,55 @@
+#include "nack-cache.hpp"
+#include "test-common.hpp"
+
+namespace cledger::tests {
+
+using ledger::NackCache;
+
+BOOST_FIXTURE_TEST_SUITE(TestNackCache, UnitTestTimeFixture)
+
+static std::shared_ptr<const Data>
+makeNack(const Name& name)
+{
+  auto data = std::make_shared<Data>(Name(name).append("nack").appendTimestamp());
+  data->setContentType(ndn::tlv::ContentType_Nack);
+  return data;
+}
+
+BOOST_AUTO_TEST_CASE(ReuseUntilStale)
+{
+  NackCache cache(2, 10_s);
+  Name n1("/ndn/site1/RECORD/1"), n2("/ndn/site1/RECORD/2"), n3("/ndn/site1/RECORD/3");
+
+  auto nack1 = makeNack(n1);
+  cache.insert(n1, nack1);
+  cache.insert(n2, makeNack(n2));
+  BOOST_CHECK_EQUAL(cache.find(n1), nack1);
+  BOOST_CHECK(cache.find(n3) == nullptr);
+
+  // n1 was used last, n2 goes
+  cache.insert(n3, makeNack(n3));
+  BOOST_CHECK_EQUAL(cache.size(), 2);
+  BOOST_CHECK(cache.find(n2) == nullptr);
+
+  // n3 now exists
+  cache.erase(n3);
+  BOOST_CHECK(cache.find(n3) == nullptr);
+
+  advanceClocks(1_s, 9);
+  BOOST_CHECK_EQUAL(cache.find(n1), nack1);
+  advanceClocks(1_s);
+  BOOST_CHECK(cache.find(n1) == nullptr);
+  BOOST_CHECK_EQUAL(cache.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Disabled)
+{
+  NackCache cache(0, 10_s);
+  Name n1("/ndn/site1/RECORD/1");
+  cache.insert(n1, makeNack(n1));
+  BOOST_CHECK(cache.find(n1) == nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestNackCache
+
+} // namespace cledger::tests
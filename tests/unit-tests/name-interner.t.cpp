@@ -0,0 +1,117 @@
+#include "dag/name-interner.hpp"
+#include "storage/ledger-memory.hpp"
+#include "test-common.hpp"
+
+namespace cledger::tests {
+
+using dag::NameInterner;
+
+BOOST_AUTO_TEST_SUITE(TestNameInterner)
+
+BOOST_AUTO_TEST_CASE(InternAndLookup)
+{
+  auto storage = storage::LedgerStorage::createLedgerStorage("storage-memory", "/test/ledger", "");
+  NameInterner interner(storage->getInterface());
+  BOOST_CHECK_EQUAL(interner.intern("/a/1"), 0);
+  BOOST_CHECK_EQUAL(interner.intern("/b/1"), 1);
+  BOOST_CHECK_EQUAL(interner.intern("/a/1"), 0);
+  BOOST_CHECK_EQUAL(interner.size(), 2);
+
+  BOOST_CHECK_EQUAL(interner.lookup(1), Name("/b/1"));
+  BOOST_CHECK_EQUAL(*interner.find("/a/1"), 0);
+  BOOST_CHECK(!interner.find("/c/1"));
+  BOOST_CHECK_THROW(interner.lookup(2), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(Persistence)
+{
+  auto storage = storage::LedgerStorage::createLedgerStorage("storage-memory", "/test/ledger", "");
+  {
+    NameInterner interner(storage->getInterface());
+    for (int i = 0; i < 10; i++) {
+      interner.intern(Name("/a").appendNumber(i));
+    }
+    interner.flush();
+    interner.intern("/b/1");
+    interner.flush();
+    // lost on restart, nothing persisted may refer to it yet
+    interner.intern("/c/1");
+  }
+
+  NameInterner reloaded(storage->getInterface());
+  BOOST_CHECK_EQUAL(reloaded.size(), 11);
+  for (int i = 0; i < 10; i++) {
+    BOOST_CHECK_EQUAL(*reloaded.find(Name("/a").appendNumber(i)), i);
+  }
+  BOOST_CHECK_EQUAL(*reloaded.find("/b/1"), 10);
+  BOOST_CHECK(!reloaded.find("/c/1"));
+
+  // appends continue after the stored segments
+  BOOST_CHECK_EQUAL(reloaded.intern("/c/1"), 11);
+  reloaded.flush();
+  NameInterner again(storage->getInterface());
+  BOOST_CHECK_EQUAL(*again.find("/c/1"), 11);
+}
+
+BOOST_AUTO_TEST_CASE(Pages)
+{
+  auto storage = storage::LedgerStorage::createLedgerStorage("storage-memory", "/test/ledger", "");
+  const size_t nNames = 3 * NameInterner::PAGE_SIZE + 5;
+  {
+    NameInterner interner(storage->getInterface());
+    for (size_t i = 0; i < nNames; i++) {
+      interner.intern(Name("/a").appendNumber(i));
+      // one flush per Name, as the DAG does, rewrites the last page each time
+      interner.flush();
+    }
+  }
+
+  // pages are read as their IDs or Names are asked for
+  NameInterner reloaded(storage->getInterface());
+  BOOST_CHECK_EQUAL(reloaded.size(), nNames);
+  BOOST_CHECK_EQUAL(reloaded.lookup(NameInterner::PAGE_SIZE + 3), Name("/a").appendNumber(NameInterner::PAGE_SIZE + 3));
+  BOOST_CHECK_EQUAL(*reloaded.find(Name("/a").appendNumber(2 * NameInterner::PAGE_SIZE)), 2 * NameInterner::PAGE_SIZE);
+  BOOST_CHECK_EQUAL(reloaded.lookup(0), Name("/a").appendNumber(0));
+  BOOST_CHECK_THROW(reloaded.lookup(nNames), std::out_of_range);
+
+  // the last page fills up and a new one starts
+  for (size_t i = nNames; i < 4 * NameInterner::PAGE_SIZE + 1; i++) {
+    BOOST_CHECK_EQUAL(reloaded.intern(Name("/a").appendNumber(i)), i);
+  }
+  reloaded.flush();
+  NameInterner again(storage->getInterface());
+  BOOST_CHECK_EQUAL(again.size(), 4 * NameInterner::PAGE_SIZE + 1);
+  BOOST_CHECK_EQUAL(again.lookup(4 * NameInterner::PAGE_SIZE), Name("/a").appendNumber(4 * NameInterner::PAGE_SIZE));
+  BOOST_CHECK_EQUAL(*again.find(Name("/a").appendNumber(nNames)), nNames);
+}
+
+BOOST_AUTO_TEST_CASE(LegacySegments)
+{
+  // two segments as earlier versions flushed them
+  auto storage = storage::LedgerStorage::createLedgerStorage("storage-memory", "/test/ledger", "");
+  for (uint64_t segment = 0; segment < 2; segment++) {
+    Block block(421);
+    block.push_back(ndn::makeNonNegativeIntegerBlock(422, segment * 3));
+    for (uint64_t i = segment * 3; i < segment * 3 + 3; i++) {
+      block.push_back(Name("/a").appendNumber(i).wireEncode());
+    }
+    block.encode();
+    storage->addBlock(Name(dag::nameTableNameHeader).appendNumber(segment), block);
+  }
+
+  {
+    NameInterner migrated(storage->getInterface());
+    BOOST_CHECK_EQUAL(migrated.size(), 6);
+    BOOST_CHECK_EQUAL(migrated.lookup(4), Name("/a").appendNumber(4));
+  }
+  BOOST_CHECK_THROW(storage->getBlock(Name(dag::nameTableNameHeader).appendNumber(0)), std::exception);
+
+  NameInterner reloaded(storage->getInterface());
+  BOOST_CHECK_EQUAL(reloaded.size(), 6);
+  BOOST_CHECK_EQUAL(*reloaded.find(Name("/a").appendNumber(5)), 5);
+  BOOST_CHECK_EQUAL(reloaded.intern("/b/1"), 6);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestNameInterner
+
+} // namespace cledger::tests
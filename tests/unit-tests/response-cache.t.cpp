@@ -0,0 +1,62 @@
+#include "response-cache.hpp"
+#include "test-common.hpp"
+
+namespace cledger::tests {
+
+using ledger::ResponseCache;
+
+BOOST_FIXTURE_TEST_SUITE(TestResponseCache, IdentityManagementFixture)
+
+static ResponseCache::ObjectPtr
+makeResponse(ndn::KeyChain& keyChain, const Name& queryName)
+{
+  util::segment::SegmentedObject::Options opts;
+  opts.signingInfo = ndn::signingWithSha256();
+  Block content(ndn::tlv::Content);
+  content.encode();
+  return std::make_shared<util::segment::SegmentedObject>(Name(queryName).append("data").appendVersion(),
+                                                          content, keyChain, opts);
+}
+
+BOOST_AUTO_TEST_CASE(LookupAndInvalidate)
+{
+  ResponseCache cache(2);
+  Name q1("/ndn/site1/RECORD/1"), q2("/ndn/site1/RECORD/2"), q3("/ndn/site1/RECORD/3");
+
+  auto r1 = makeResponse(m_keyChain, q1);
+  cache.insert(q1, 1, r1);
+  cache.insert(q2, 2, makeResponse(m_keyChain, q2));
+  BOOST_CHECK_EQUAL(cache.find(q1), r1);
+  BOOST_CHECK(cache.find(q3) == nullptr);
+
+  // q1 was used last, q2 goes
+  cache.insert(q3, 3, makeResponse(m_keyChain, q3));
+  BOOST_CHECK_EQUAL(cache.size(), 2);
+  BOOST_CHECK(cache.find(q2) == nullptr);
+  BOOST_CHECK(cache.find(q1) != nullptr);
+
+  // the state of q1 changed
+  cache.invalidate(1);
+  BOOST_CHECK(cache.find(q1) == nullptr);
+  BOOST_CHECK_EQUAL(cache.size(), 1);
+  cache.invalidate(1);
+
+  // a newer response to the same query replaces the cached one
+  auto r3 = makeResponse(m_keyChain, q3);
+  cache.insert(q3, 3, r3);
+  BOOST_CHECK_EQUAL(cache.find(q3), r3);
+  BOOST_CHECK_EQUAL(cache.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(Disabled)
+{
+  ResponseCache cache(0);
+  Name q1("/ndn/site1/RECORD/1");
+  cache.insert(q1, 1, makeResponse(m_keyChain, q1));
+  BOOST_CHECK(cache.find(q1) == nullptr);
+  BOOST_CHECK_EQUAL(cache.size(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestResponseCache
+
+} // namespace cledger::tests
@@ -0,0 +1,122 @@
+#include "util/segment/segment-server.hpp"
+#include "test-common.hpp"
+
+namespace cledger::tests {
+
+using ndn::DummyClientFace;
+using util::segment::SegmentServer;
+
+BOOST_FIXTURE_TEST_SUITE(TestSegmentServer, IdentityManagementTimeFixture)
+
+static shared_ptr<const util::segment::SegmentedObject>
+makeObject(ndn::KeyChain& keyChain, const Name& name, size_t size)
+{
+  util::segment::SegmentedObject::Options opts;
+  opts.signingInfo = ndn::signingWithSha256();
+  opts.maxSegmentSize = 10;
+  std::vector<uint8_t> buffer(size, 0xAB);
+  return std::make_shared<util::segment::SegmentedObject>(Name(name).appendVersion(1),
+                                                          ndn::makeBinaryBlock(ndn::tlv::Content, buffer),
+                                                          keyChain, opts);
+}
+
+BOOST_AUTO_TEST_CASE(ServeAndExpire)
+{
+  DummyClientFace face(io, m_keyChain, {true, true});
+  SegmentServer::Options opts;
+  opts.sessionLength = 3_s;
+  opts.tick = 1_s;
+  SegmentServer server(face, opts);
+
+  auto object = makeObject(m_keyChain, "/ndn/site1/RECORD/1/data", 25);
+  BOOST_CHECK_EQUAL(object->size(), 3);
+  server.publish(object);
+  BOOST_CHECK_EQUAL(server.size(), 1);
+  BOOST_CHECK_EQUAL(server.getBytes(), object->getBytes());
+
+  BOOST_CHECK(server.serve(Interest(Name(object->getVersionedName()).appendSegment(1))));
+  BOOST_CHECK_EQUAL(face.sentData.back().getName(), object->getSegment(1).getName());
+  // the version alone gets the first segment
+  BOOST_CHECK(server.serve(Interest(object->getVersionedName())));
+  BOOST_CHECK_EQUAL(face.sentData.back().getName(), object->getSegment(0).getName());
+  BOOST_CHECK(server.serve(Interest(Name(object->getVersionedName()).appendSegment(3))));
+  BOOST_CHECK_EQUAL(face.sentNacks.size(), 1);
+  BOOST_CHECK(!server.serve(Interest(Name("/ndn/site1/RECORD/2/data").appendVersion(1).appendSegment(0))));
+  BOOST_CHECK(!server.serve(Interest("/ndn/site1/RECORD/1")));
+  BOOST_CHECK_EQUAL(face.sentData.size(), 2);
+
+  // publishing again restarts the session
+  advanceClocks(500_ms, 4);
+  server.publish(object);
+  advanceClocks(500_ms, 6);
+  BOOST_CHECK(server.serve(Interest(Name(object->getVersionedName()).appendSegment(2))));
+
+  advanceClocks(500_ms, 2);
+  BOOST_CHECK_EQUAL(server.size(), 0);
+  BOOST_CHECK_EQUAL(server.getBytes(), 0);
+  BOOST_CHECK(!server.serve(Interest(Name(object->getVersionedName()).appendSegment(2))));
+}
+
+BOOST_AUTO_TEST_CASE(MemoryBudget)
+{
+  DummyClientFace face(io, m_keyChain, {true, true});
+  auto o1 = makeObject(m_keyChain, "/ndn/site1/RECORD/1/data", 25);
+  auto o2 = makeObject(m_keyChain, "/ndn/site1/RECORD/2/data", 25);
+  auto o3 = makeObject(m_keyChain, "/ndn/site1/RECORD/3/data", 25);
+  SegmentServer::Options opts;
+  opts.memoryBudget = o1->getBytes() + o2->getBytes() + o3->getBytes() - 1;
+  SegmentServer server(face, opts);
+
+  server.publish(o1);
+  advanceClocks(1_s);
+  server.publish(o2);
+  server.publish(o3);
+  // the oldest session goes first
+  BOOST_CHECK_EQUAL(server.size(), 2);
+  BOOST_CHECK(!server.serve(Interest(o1->getVersionedName())));
+  BOOST_CHECK(server.serve(Interest(o2->getVersionedName())));
+  BOOST_CHECK(server.serve(Interest(o3->getVersionedName())));
+  BOOST_CHECK_LE(server.getBytes(), opts.memoryBudget);
+
+  // an object over the whole budget is still served
+  auto large = makeObject(m_keyChain, "/ndn/site1/RECORD/4/data", 100);
+  opts.memoryBudget = 0;
+  SegmentServer tight(face, opts);
+  tight.publish(o1);
+  tight.publish(large);
+  BOOST_CHECK_EQUAL(tight.size(), 1);
+  BOOST_CHECK(tight.serve(Interest(large->getVersionedName())));
+}
+
+BOOST_AUTO_TEST_CASE(SignedSegments)
+{
+  DummyClientFace face(io, m_keyChain, {true, true});
+  auto o1 = makeObject(m_keyChain, "/ndn/site1/RECORD/1/data", 25);
+  auto o2 = makeObject(m_keyChain, "/ndn/site1/RECORD/2/data", 25);
+  SegmentServer::Options opts;
+  // room for both as published, not for one more signed segment
+  opts.memoryBudget = o1->getBytes() + o2->getBytes() + 10;
+  SegmentServer server(face, opts);
+
+  server.publish(o1);
+  advanceClocks(1_s);
+  server.publish(o2);
+  BOOST_CHECK_EQUAL(server.size(), 2);
+
+  // signing a segment to serve it adds its wire to what the session holds
+  auto before = o2->getBytes();
+  BOOST_CHECK(server.serve(Interest(Name(o2->getVersionedName()).appendSegment(1))));
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(o2->getBytes(), before + face.sentData.back().wireEncode().size());
+  BOOST_CHECK_EQUAL(server.size(), 1);
+  BOOST_CHECK_EQUAL(server.getBytes(), o2->getBytes());
+  BOOST_CHECK(!server.serve(Interest(o1->getVersionedName())));
+
+  // serving it again holds nothing more
+  BOOST_CHECK(server.serve(Interest(Name(o2->getVersionedName()).appendSegment(1))));
+  BOOST_CHECK_EQUAL(server.getBytes(), o2->getBytes());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestSegmentServer
+
+} // namespace cledger::tests
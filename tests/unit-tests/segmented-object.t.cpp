@@ -0,0 +1,89 @@
+#include "util/segment/segmented-object.hpp"
+#include "test-common.hpp"
+
+namespace cledger::tests {
+
+using util::segment::SegmentedObject;
+
+BOOST_FIXTURE_TEST_SUITE(TestSegmentedObject, IdentityManagementFixture)
+
+BOOST_AUTO_TEST_CASE(LazySigning)
+{
+  SegmentedObject::Options opts;
+  opts.signingInfo = ndn::signingWithSha256();
+  opts.maxSegmentSize = 10;
+  std::vector<uint8_t> buffer(95, 0xAB);
+  auto block = ndn::makeBinaryBlock(ndn::tlv::Content, buffer);
+  SegmentedObject object(Name("/ndn/site1/RECORD/1/data").appendVersion(1), block, m_keyChain, opts);
+
+  BOOST_CHECK_EQUAL(object.size(), 10);
+  // only the first segment is signed up front
+  BOOST_CHECK_EQUAL(object.getSignedCount(), 1);
+  BOOST_CHECK(ndn::security::verifyDigest(object.getSegment(0), ndn::DigestAlgorithm::SHA256));
+
+  const auto& last = object.getSegment(9);
+  BOOST_CHECK_EQUAL(object.getSignedCount(), 2);
+  BOOST_CHECK(ndn::security::verifyDigest(last, ndn::DigestAlgorithm::SHA256));
+  BOOST_CHECK_EQUAL(last.getName(), Name(object.getVersionedName()).appendSegment(9));
+  BOOST_CHECK_EQUAL(last.getFinalBlock().value(), Name::Component::fromSegment(9));
+  BOOST_CHECK_EQUAL(last.getContent().value_size(), 7);
+  // signed once, served from then on
+  BOOST_CHECK_EQUAL(&object.getSegment(9), &last);
+  BOOST_CHECK_EQUAL(object.getSignedCount(), 2);
+
+  // the segments put back together
+  std::vector<uint8_t> wire;
+  for (size_t i = 0; i < object.size(); i++) {
+    auto content = object.getSegment(i).getContent();
+    wire.insert(wire.end(), content.value_begin(), content.value_end());
+  }
+  BOOST_CHECK_EQUAL_COLLECTIONS(wire.begin(), wire.end(), block.begin(), block.end());
+  BOOST_CHECK_EQUAL(object.getSignedCount(), 10);
+}
+
+BOOST_AUTO_TEST_CASE(Manifest)
+{
+  SegmentedObject::Options opts;
+  opts.signingInfo = ndn::signingWithSha256();
+  opts.maxSegmentSize = 120;
+  opts.useManifest = true;
+  std::vector<uint8_t> buffer(295, 0xAB);
+  auto block = ndn::makeBinaryBlock(ndn::tlv::Content, buffer);
+  SegmentedObject object(Name("/ndn/site1/RECORD/1/data").appendVersion(1), block, m_keyChain, opts);
+
+  // three chunks behind the manifest, one signature
+  BOOST_CHECK(object.hasManifest());
+  BOOST_CHECK_EQUAL(object.size(), 4);
+  BOOST_CHECK_EQUAL(object.getSignedCount(), 1);
+
+  const auto& manifest = object.getSegment(0).getContent();
+  manifest.parse();
+  BOOST_CHECK_EQUAL(manifest.elements_size(), 3);
+  std::vector<uint8_t> wire;
+  for (size_t i = 1; i < object.size(); i++) {
+    const auto& segment = object.getSegment(i);
+    BOOST_CHECK_EQUAL(segment.getSignatureType(), ndn::tlv::DigestSha256);
+    BOOST_CHECK_EQUAL(segment.getFullName().get(-1), Name::Component(manifest.elements()[i - 1]));
+    auto content = segment.getContent();
+    wire.insert(wire.end(), content.value_begin(), content.value_end());
+  }
+  BOOST_CHECK_EQUAL_COLLECTIONS(wire.begin(), wire.end(), block.begin(), block.end());
+  BOOST_CHECK_EQUAL(object.getSignedCount(), 1);
+
+  // the manifest is held once, in the wire of segment 0
+  size_t bytes = block.size() + object.size() * Name(object.getVersionedName()).appendSegment(3).wireEncode().size();
+  for (size_t i = 0; i < object.size(); i++) {
+    bytes += object.getSegment(i).wireEncode().size();
+  }
+  BOOST_CHECK_EQUAL(object.getBytes(), bytes);
+
+  // a single chunk needs no manifest
+  SegmentedObject small(Name("/ndn/site1/RECORD/2/data").appendVersion(1),
+                        ndn::makeBinaryBlock(ndn::tlv::Content, std::vector<uint8_t>(10)), m_keyChain, opts);
+  BOOST_CHECK(!small.hasManifest());
+  BOOST_CHECK_EQUAL(small.size(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestSegmentedObject
+
+} // namespace cledger::tests
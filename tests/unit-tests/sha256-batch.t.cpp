@@ -0,0 +1,71 @@
+#include "util/sha256-batch.hpp"
+#include "test-common.hpp"
+
+#include <cstring>
+
+namespace cledger::tests {
+
+BOOST_AUTO_TEST_SUITE(TestSha256Batch)
+
+BOOST_AUTO_TEST_CASE(MatchesSha256)
+{
+  // every length up to three blocks, crossing the one- and two-block padding cases
+  std::vector<Buffer> payloads;
+  for (size_t len = 0; len <= 192; len++) {
+    Buffer payload(len);
+    for (size_t i = 0; i < len; i++) {
+      payload[i] = static_cast<uint8_t>(len * 31 + i);
+    }
+    payloads.push_back(std::move(payload));
+  }
+  std::vector<span<const uint8_t>> messages(payloads.begin(), payloads.end());
+
+  auto digests = util::sha256::hashMany(messages);
+  BOOST_REQUIRE_EQUAL(digests.size(), messages.size());
+  for (size_t i = 0; i < messages.size(); i++) {
+    auto expected = Sha256::computeDigest(messages[i]);
+    BOOST_CHECK_MESSAGE(std::memcmp(expected->data(), digests[i].data(), digests[i].size()) == 0,
+                        "digest mismatch for " << messages[i].size() << " bytes");
+  }
+
+  BOOST_CHECK(util::sha256::hashMany({}).empty());
+}
+
+BOOST_AUTO_TEST_CASE(EveryImplementation)
+{
+  // short and long messages interleaved, so that the AVX2 lanes pick up messages
+  // of other lengths as they finish, and a count that is not a multiple of eight
+  std::vector<Buffer> payloads;
+  for (size_t len = 0; len <= 130; len++) {
+    for (size_t size : {len, len * 37 + 1000}) {
+      Buffer payload(size);
+      for (size_t i = 0; i < size; i++) {
+        payload[i] = static_cast<uint8_t>(size * 7 + i);
+      }
+      payloads.push_back(std::move(payload));
+    }
+  }
+  payloads.emplace_back(64 * 1024 + 3);
+  std::vector<span<const uint8_t>> messages(payloads.begin(), payloads.end());
+
+  auto implementations = util::sha256::getSupportedImplementations();
+  BOOST_CHECK_EQUAL(implementations.front(), util::sha256::getImplementation());
+  BOOST_CHECK_EQUAL(implementations.back(), "portable");
+  for (const auto& impl : implementations) {
+    BOOST_TEST_MESSAGE("Checking the " << impl << " implementation");
+    auto digests = util::sha256::hashManyWith(impl, messages);
+    BOOST_REQUIRE_EQUAL(digests.size(), messages.size());
+    for (size_t i = 0; i < messages.size(); i++) {
+      auto expected = Sha256::computeDigest(messages[i]);
+      BOOST_CHECK_MESSAGE(std::memcmp(expected->data(), digests[i].data(), digests[i].size()) == 0,
+                          impl << " digest mismatch for " << messages[i].size() << " bytes");
+    }
+    BOOST_CHECK(util::sha256::hashManyWith(impl, {}).empty());
+  }
+
+  BOOST_CHECK_THROW(util::sha256::hashManyWith("unknown", messages), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestSha256Batch
+
+} // namespace cledger::tests
@@ -0,0 +1,106 @@
+#include "dag/status-index.hpp"
+#include "storage/ledger-memory.hpp"
+#include "test-common.hpp"
+
+namespace cledger::tests {
+
+using dag::StatusIndex;
+
+BOOST_AUTO_TEST_SUITE(TestStatusIndex)
+
+BOOST_AUTO_TEST_CASE(PendingAndInterlocked)
+{
+  auto storage = storage::LedgerStorage::createLedgerStorage("storage-memory", "/test/ledger", "");
+  auto interner = std::make_shared<dag::NameInterner>(storage->getInterface());
+  StatusIndex index(interner);
+
+  auto t0 = time::system_clock::now();
+  index.addPending("/32=EdgeState/r/1", t0 + 20_ms);
+  index.addPending("/32=EdgeState/r/2", t0);
+  index.addPending("/32=EdgeState/r/3", t0 + 10_ms);
+  // already indexed, the first creation time stays
+  index.addPending("/32=EdgeState/r/2", t0 + 50_ms);
+  BOOST_CHECK_EQUAL(index.getPendingCount(), 3);
+  BOOST_CHECK_EQUAL(index.getInterlockedCount(), 0);
+
+  auto status = index.getStatus();
+  BOOST_CHECK_EQUAL(status.oldestPending, Name("/32=EdgeState/r/2"));
+  BOOST_CHECK(status.oldestPendingCreated == t0);
+
+  index.markInterlocked("/32=EdgeState/r/2", t0 + 100_ms);
+  index.markInterlocked("/32=EdgeState/r/3", t0 + 50_ms);
+  // a second harvest of the same record is not counted twice
+  index.markInterlocked("/32=EdgeState/r/3", t0 + 70_ms);
+  // interlocked before this index was built
+  index.markInterlocked("/32=EdgeState/r/4", t0);
+  BOOST_CHECK_EQUAL(index.getPendingCount(), 1);
+  BOOST_CHECK_EQUAL(index.getInterlockedCount(), 3);
+  BOOST_CHECK(index.isPending("/32=EdgeState/r/1"));
+  BOOST_CHECK(!index.isPending("/32=EdgeState/r/2"));
+  BOOST_CHECK(*index.getInterlockTime("/32=EdgeState/r/3") == t0 + 50_ms);
+  BOOST_CHECK(!index.getInterlockTime("/32=EdgeState/r/1"));
+
+  // interlocked records do not go back to pending
+  index.addPending("/32=EdgeState/r/4", t0);
+  BOOST_CHECK_EQUAL(index.getPendingCount(), 1);
+
+  status = index.getStatus();
+  BOOST_CHECK_EQUAL(status.pending, 1);
+  BOOST_CHECK_EQUAL(status.interlocked, 3);
+  BOOST_CHECK_EQUAL(status.oldestPending, Name("/32=EdgeState/r/1"));
+  BOOST_CHECK_EQUAL(status.latencySamples, 2);
+  BOOST_CHECK_EQUAL(status.minLatency, 40_ms);
+  BOOST_CHECK_EQUAL(status.meanLatency, 70_ms);
+  BOOST_CHECK_EQUAL(status.maxLatency, 100_ms);
+
+  auto decoded = dag::decodeLedgerStatus(dag::encodeLedgerStatus(status));
+  BOOST_CHECK_EQUAL(decoded.pending, 1);
+  BOOST_CHECK_EQUAL(decoded.interlocked, 3);
+  BOOST_CHECK_EQUAL(decoded.oldestPending, status.oldestPending);
+  BOOST_CHECK_EQUAL(decoded.latencySamples, 2);
+  BOOST_CHECK_EQUAL(decoded.meanLatency, 70_ms);
+}
+
+BOOST_AUTO_TEST_CASE(Snapshot)
+{
+  auto storage = storage::LedgerStorage::createLedgerStorage("storage-memory", "/test/ledger", "");
+  auto interner = std::make_shared<dag::NameInterner>(storage->getInterface());
+  StatusIndex index(interner);
+
+  // creation times are kept in milliseconds
+  auto t0 = time::fromUnixTimestamp(time::toUnixTimestamp(time::system_clock::now()));
+  index.addPending("/32=EdgeState/r/1", t0 + 20_ms);
+  index.addPending("/32=EdgeState/r/2", t0);
+  index.addPending("/32=EdgeState/r/3", t0 + 10_ms);
+  index.markInterlocked("/32=EdgeState/r/2", t0 + 100_ms);
+  index.markInterlocked("/32=EdgeState/r/4", t0);
+  auto snapshot = index.encodeSnapshot();
+
+  StatusIndex restored(std::make_shared<dag::NameInterner>(storage->getInterface()));
+  restored.loadSnapshot(snapshot);
+  BOOST_CHECK_EQUAL(restored.getPendingCount(), 2);
+  BOOST_CHECK_EQUAL(restored.getInterlockedCount(), 2);
+  BOOST_CHECK(restored.isPending("/32=EdgeState/r/3"));
+  auto pending = restored.listPending();
+  BOOST_REQUIRE_EQUAL(pending.size(), 2);
+  BOOST_CHECK_EQUAL(pending[0], Name("/32=EdgeState/r/3"));
+  BOOST_CHECK_EQUAL(pending[1], Name("/32=EdgeState/r/1"));
+
+  // the aggregates go on from where they were
+  restored.markInterlocked("/32=EdgeState/r/3", t0 + 50_ms);
+  auto status = restored.getStatus();
+  BOOST_CHECK_EQUAL(status.pending, 1);
+  BOOST_CHECK_EQUAL(status.interlocked, 3);
+  BOOST_CHECK_EQUAL(status.oldestPending, Name("/32=EdgeState/r/1"));
+  BOOST_CHECK(status.oldestPendingCreated == t0 + 20_ms);
+  BOOST_CHECK_EQUAL(status.latencySamples, 2);
+  BOOST_CHECK_EQUAL(status.minLatency, 40_ms);
+  BOOST_CHECK_EQUAL(status.meanLatency, 70_ms);
+  BOOST_CHECK_EQUAL(status.maxLatency, 100_ms);
+
+  BOOST_CHECK_THROW(restored.loadSnapshot(dag::encodeLedgerStatus(status)), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestStatusIndex
+
+} // namespace cledger::tests
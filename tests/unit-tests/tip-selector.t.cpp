@@ -0,0 +1,55 @@
+#include "dag/tip-selector.hpp"
+#include "test-common.hpp"
+
+namespace cledger::tests {
+
+using dag::EdgeState;
+using dag::tip::TipSelector;
+
+BOOST_AUTO_TEST_SUITE(TestTipSelector)
+
+static EdgeState
+makeTip(const std::string& producer, uint64_t seq, int createdSec)
+{
+  EdgeState state;
+  state.stateName = dag::toStateName(Name("/ndn").append(producer).appendNumber(seq));
+  state.status = EdgeState::LOADED;
+  state.created = time::system_clock::time_point(time::seconds(createdSec));
+  return state;
+}
+
+BOOST_AUTO_TEST_CASE(All)
+{
+  std::vector<EdgeState> tips{makeTip("a", 1, 1), makeTip("b", 1, 2), makeTip("c", 1, 3)};
+  auto unbounded = TipSelector::createTipSelector("tips-all", 0);
+  BOOST_CHECK_EQUAL(unbounded->select(tips, Name("/ndn/a")).size(), 3);
+  auto bounded = TipSelector::createTipSelector("tips-all", 2);
+  BOOST_CHECK_EQUAL(bounded->select(tips, Name("/ndn/a")).size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(Interlock)
+{
+  std::vector<EdgeState> tips{
+    makeTip("self", 1, 1), makeTip("self", 2, 2),
+    makeTip("a", 2, 6), makeTip("a", 1, 3),
+    makeTip("b", 1, 4), makeTip("b", 2, 5),
+  };
+  auto selector = TipSelector::createTipSelector("tips-interlock", 3);
+  auto selected = selector->select(tips, Name("/ndn/self"));
+  // one tip per other producer first, oldest producer first, then the next oldest
+  std::list<Name> expected{Name("/ndn/a").appendNumber(1), Name("/ndn/b").appendNumber(1),
+                           Name("/ndn/a").appendNumber(2)};
+  BOOST_CHECK_EQUAL_COLLECTIONS(selected.begin(), selected.end(), expected.begin(), expected.end());
+
+  // own records only fill what is left
+  auto unbounded = TipSelector::createTipSelector("tips-interlock", 0);
+  selected = unbounded->select(tips, Name("/ndn/self"));
+  BOOST_REQUIRE_EQUAL(selected.size(), 6);
+  BOOST_CHECK_EQUAL(selected.back(), Name("/ndn/self").appendNumber(2));
+
+  BOOST_CHECK(TipSelector::createTipSelector("tips-unknown", 0) == nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestTipSelector
+
+} // namespace cledger::tests
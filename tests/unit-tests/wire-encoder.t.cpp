@@ -0,0 +1,90 @@
+#include "util/wire-encoder.hpp"
+#include "util/segment/segmented-object.hpp"
+#include "allocation-counter.hpp"
+#include "test-common.hpp"
+
+namespace cledger::tests {
+
+BOOST_FIXTURE_TEST_SUITE(TestWireEncoder, IdentityManagementFixture)
+
+BOOST_AUTO_TEST_CASE(SameAsEncode)
+{
+  std::vector<Block> elements;
+  for (size_t i = 0; i < 40; i++) {
+    Data data(Name("/ndn/site1/RECORD").appendNumber(i));
+    data.setContent(std::vector<uint8_t>(i * 10, 0xAB));
+    m_keyChain.sign(data, ndn::signingWithSha256());
+    elements.push_back(data.wireEncode());
+  }
+
+  Block expected(ndn::tlv::Content);
+  for (const auto& element : elements) {
+    expected.push_back(element);
+  }
+  expected.encode();
+
+  auto content = util::encodeWires(ndn::tlv::Content, elements);
+  BOOST_CHECK_EQUAL_COLLECTIONS(content.begin(), content.end(), expected.begin(), expected.end());
+  content.parse();
+  BOOST_CHECK_EQUAL(content.elements_size(), elements.size());
+
+  BOOST_CHECK_EQUAL(util::encodeWires(ndn::tlv::Content, span<const Block>()), ndn::makeEmptyBlock(ndn::tlv::Content));
+}
+
+BOOST_AUTO_TEST_CASE(OneCopy)
+{
+  std::vector<Block> elements;
+  for (size_t i = 0; i < 40; i++) {
+    elements.push_back(ndn::makeBinaryBlock(ndn::tlv::Content, std::vector<uint8_t>(100 + i, 0xAB)));
+  }
+
+  // a single buffer of the exact size, whatever the number of elements; the
+  // only slack over the content is the shared_ptr's own bookkeeping
+  auto count = getAllocationCount();
+  auto bytes = getAllocatedBytes();
+  auto content = util::encodeWires(ndn::tlv::Content, elements);
+  auto nAllocations = getAllocationCount() - count;
+  auto nBytes = getAllocatedBytes() - bytes;
+  BOOST_TEST_MESSAGE("encodeWires: " << nAllocations << " allocations, " << nBytes << " bytes for "
+                     << content.size() << " bytes of content");
+  BOOST_CHECK_LE(nAllocations, 2);
+  BOOST_CHECK_GE(nBytes, content.size());
+  BOOST_CHECK_LE(nBytes, content.size() + 128);
+
+  count = getAllocationCount();
+  util::encodeWires(ndn::tlv::Content, make_span(elements).first(3));
+  BOOST_CHECK_EQUAL(getAllocationCount() - count, nAllocations);
+}
+
+BOOST_AUTO_TEST_CASE(SharedWithSegments)
+{
+  std::vector<Block> elements(40, ndn::makeBinaryBlock(ndn::tlv::Content, std::vector<uint8_t>(1000, 0xAB)));
+  auto content = util::encodeWires(ndn::tlv::Content, elements);
+
+  util::segment::SegmentedObject::Options opts;
+  opts.signingInfo = ndn::signingWithSha256();
+  opts.maxSegmentSize = 4000;
+  auto bytes = getAllocatedBytes();
+  util::segment::SegmentedObject object(Name("/ndn/site1/RECORD/1/data").appendVersion(1), content,
+                                        m_keyChain, opts);
+  // only the first segment is cut from the content before it is served
+  BOOST_CHECK_EQUAL(object.getCopiedBytes(), 4000);
+  BOOST_CHECK_LT(getAllocatedBytes() - bytes, content.size());
+  bytes = getAllocatedBytes();
+  for (size_t i = 0; i < object.size(); i++) {
+    object.getSegment(i);
+  }
+  BOOST_CHECK_EQUAL(object.getCopiedBytes(), content.size());
+  // the rest of the content is copied when the other segments are signed
+  BOOST_CHECK_GE(getAllocatedBytes() - bytes, content.size() - 4000);
+  // and the signed copies are held on top of the shared content
+  auto held = object.getBytes();
+  BOOST_CHECK_GT(held, 2 * content.size());
+  object.getSegment(1);
+  BOOST_CHECK_EQUAL(object.getCopiedBytes(), content.size());
+  BOOST_CHECK_EQUAL(object.getBytes(), held);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestWireEncoder
+
+} // namespace cledger::tests
@@ -47,7 +47,7 @@ handleSignal(const boost::system::error_code& error, int signalNum)
 
 static void
 checkRecords(const Certificate& cert, const Name& ledgerName,
-             ndn::security::Validator& validator)
+             ndn::security::Validator& validator, bool withProof)
 {
   checker = std::make_shared<Checker>(face, validator);
   checker->doCheck(ledgerName, cert, 
@@ -58,7 +58,8 @@ checkRecords(const Certificate& cert, const Name& ledgerName,
     [] (auto&&, auto& i) {
       std::cerr << "ERROR: Failed because of: " << i << std::endl;
       face.getIoContext().stop();
-    }
+    },
+    withProof
   );
 }
 static int
@@ -79,6 +80,7 @@ main(int argc, char* argv[])
   bool isIdentityName = false;
   bool isKeyName = false;
   bool isFileName = false;
+  bool withProof = false;
   std::string ledgerPrefix;
 
   po::options_description description(
@@ -87,6 +89,9 @@ main(int argc, char* argv[])
     "Options");
   description.add_options()
     ("help,h",           "produce help message")
+    ("proof,p",          po::bool_switch(&withProof),
+                         "ask for an inclusion proof under the ledger's signed tree head "
+                         "instead of the descendant records")
     ("identity,i",       po::bool_switch(&isIdentityName),
                          "treat the NAME argument as an identity name (e.g., /ndn/edu/ucla/cs/tianyuan)")
     ("key,k",            po::bool_switch(&isKeyName),
@@ -149,7 +154,7 @@ main(int argc, char* argv[])
   }
   std::cerr << "Checking " << certificate.getName() << "...\n";
   validator.load(validatorFilePath);
-  checkRecords(certificate, Name(ledgerPrefix), validator);
+  checkRecords(certificate, Name(ledgerPrefix), validator, withProof);
   face.processEvents();
   return 0;
 }
@@ -1,5 +1,6 @@
 #include "ledger-module.hpp"
 #include "dag/edge-state-list.hpp"
+#include "dag/status-index.hpp"
 #include "util/segment/consumer.hpp"
 #include "util/segment/pipeline-interests-fixed.hpp"
 #include <boost/program_options/options_description.hpp>
@@ -53,11 +54,12 @@ fetchEdgeState(const Name& instancePrefix,
   );
 }
 
+// the tracker is a chain of pages, each one fetched once the previous one names it
 static void
-fetchEdgeStateList(const Name& instancePrefix, bool isBenchmark)
+fetchEdgeStateList(const Name& instancePrefix, const Name& listName, bool isBenchmark)
 {
   auto interestName = Name(instancePrefix).appendKeyword("internal")
-                                          .append(dag::toStateListName(dag::globalTracker));
+                                          .append(listName);
   Interest listFetcher(interestName);
   listFetcher.setCanBePrefix(true);
   listFetcher.setMustBeFresh(true);
@@ -66,10 +68,37 @@ fetchEdgeStateList(const Name& instancePrefix, bool isBenchmark)
       // /<obj>/data/<version>/<segment>
       auto consumer = std::make_shared<util::segment::Consumer>(validator, [=] (auto& block) {
         dag::EdgeStateList statesTracker = dag::decodeEdgeStateList(block);
-        std::cerr << "There are " << statesTracker.value.size() << " EdgeStates: " << std::endl;
+        std::cerr << "There are " << statesTracker.value.size() << " EdgeStates in "
+                  << statesTracker.listName << ": " << std::endl;
         for (const auto& entry : statesTracker.value) {
           fetchEdgeState(instancePrefix, entry, isBenchmark);
         }
+        if (statesTracker.nextList != dag::getStateListNull()) {
+          fetchEdgeStateList(instancePrefix, statesTracker.nextList, isBenchmark);
+        }
+      });
+      auto pipeline = std::make_shared<util::segment::PipelineInterestsFixed>(face, options);
+      consumer->run(data.getName().getPrefix(-1), pipeline);
+      stateConsumers.push_back(consumer);
+      statePipelines.push_back(pipeline);
+    },
+    [] (auto&&...) {},
+    [] (auto&&...) {});
+}
+
+// counts, oldest pending record and latency, in a single object
+static void
+fetchStatus(const Name& instancePrefix)
+{
+  auto interestName = Name(instancePrefix).appendKeyword("internal")
+                                          .append(dag::statusNameHeader);
+  Interest statusFetcher(interestName);
+  statusFetcher.setCanBePrefix(true);
+  statusFetcher.setMustBeFresh(true);
+  face.expressInterest(statusFetcher,
+    [] (auto&&, auto& data) {
+      auto consumer = std::make_shared<util::segment::Consumer>(validator, [] (auto& block) {
+        std::cerr << dag::decodeLedgerStatus(block);
       });
       auto pipeline = std::make_shared<util::segment::PipelineInterestsFixed>(face, options);
       consumer->run(data.getName().getPrefix(-1), pipeline);
@@ -87,8 +116,9 @@ main(int argc, char* argv[])
   std::string instancePrefixStr = "";
   std::string validatorFilePath;
   bool isBenchmark = false;
+  bool isSummary = false;
   po::options_description description(
-    "Usage: ndncledger-ledger-status [-h] -i instancePrefix -d validator [-b]\n"
+    "Usage: ndncledger-ledger-status [-h] -i instancePrefix -d validator [-b] [-s]\n"
     "\n"
     "Options");
   description.add_options()
@@ -97,7 +127,8 @@ main(int argc, char* argv[])
                          "ledger prefix (e.g., /ndn/site1/instance1)")
     ("validator,d",      po::value<std::string>(&validatorFilePath),
                           "the file path to load the ndn-cxx validator (e.g., trust-schema.conf)")
-    ("benchmark,b",     po::bool_switch(&isBenchmark), "only print interlock latency");
+    ("benchmark,b",     po::bool_switch(&isBenchmark), "only print interlock latency")
+    ("summary,s",       po::bool_switch(&isSummary), "only print the status summary, without fetching each EdgeState");
   po::positional_options_description p;
   po::variables_map vm;
   try {
@@ -117,7 +148,12 @@ main(int argc, char* argv[])
     return 2;
   }
   validator.load(validatorFilePath);
-  fetchEdgeStateList(Name(instancePrefixStr), isBenchmark);
+  if (isSummary) {
+    fetchStatus(Name(instancePrefixStr));
+  }
+  else {
+    fetchEdgeStateList(Name(instancePrefixStr), dag::toStateListName(dag::globalTracker), isBenchmark);
+  }
   face.processEvents();
   return 0;
 }